@@ -0,0 +1,106 @@
+#include "ActiveSet.h"
+#include <utility>
+#include <initializer_list>
+
+void ActiveSet::reset(size_t count) {
+    slots.resize(count);
+    active.resize(count);
+    wakeTimes.assign(count, -1.0);
+    wakeReasons.assign(count, SimEventType::ENEMY_IN_DETECTION_RANGE);
+    for (size_t i = 0; i < count; ++i) {
+        slots[i] = static_cast<int>(i);
+        active[i] = i;
+    }
+    wakes.clear();
+    wakes.reserve(2 * count + 1);   // queueWake compacts before it outgrows this
+}
+
+void ActiveSet::erase(size_t index) {
+    // Mirrors the store's swap-remove so the rest keep their state
+    if (index >= slots.size()) return;
+    if (slots[index] >= 0) {
+        removeActive(index);
+    }
+    
+    size_t last = slots.size() - 1;
+    if (index != last) {
+        slots[index] = slots[last];
+        wakeTimes[index] = wakeTimes[last];
+        wakeReasons[index] = wakeReasons[last];
+        if (slots[index] >= 0) {
+            active[slots[index]] = index;
+        } else {
+            // The queued wake names the old index, which collectDue now skips
+            queueWake(index);
+        }
+    }
+    slots.pop_back();
+    wakeTimes.pop_back();
+    wakeReasons.pop_back();
+}
+
+void ActiveSet::swapMembers(size_t a, size_t b) {
+    if (a == b) return;
+    std::swap(slots[a], slots[b]);
+    std::swap(wakeTimes[a], wakeTimes[b]);
+    std::swap(wakeReasons[a], wakeReasons[b]);
+    for (size_t index : { a, b }) {
+        if (slots[index] >= 0) {
+            active[slots[index]] = index;
+        } else {
+            queueWake(index);
+        }
+    }
+}
+
+void ActiveSet::queueWake(size_t index) {
+    if (wakeTimes[index] < 0.0) return;
+    wakes.push(SimEvent(wakeTimes[index], wakeReasons[index], static_cast<int>(index)));
+    
+    // Moves leave stale entries behind; rebuild from wakeTimes before they pile up
+    if (wakes.size() > 2 * slots.size()) {
+        wakes.clear();
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i] < 0 && wakeTimes[i] >= 0.0) {
+                wakes.push(SimEvent(wakeTimes[i], wakeReasons[i], static_cast<int>(i)));
+            }
+        }
+    }
+}
+
+void ActiveSet::removeActive(size_t index) {
+    // Swap-remove from the active list
+    int slot = slots[index];
+    size_t last = active.back();
+    active[slot] = last;
+    slots[last] = slot;
+    active.pop_back();
+    slots[index] = -1;
+}
+
+void ActiveSet::wake(size_t index) {
+    if (slots[index] >= 0) return;
+    slots[index] = static_cast<int>(active.size());
+    active.push_back(index);
+    wakeTimes[index] = -1.0;
+}
+
+void ActiveSet::sleep(size_t index, double wakeTime, SimEventType reason) {
+    if (slots[index] < 0) return;
+    removeActive(index);
+    
+    wakeTimes[index] = wakeTime;
+    wakeReasons[index] = reason;
+    queueWake(index);
+}
+
+void ActiveSet::collectDue(double now, std::vector<SimEvent>& due) {
+    while (!wakes.empty() && wakes.top().time <= now) {
+        SimEvent event = wakes.pop();
+        size_t index = static_cast<size_t>(event.subject);
+        // Skip wakes superseded by an earlier wake or a newer sleep
+        if (index >= slots.size() || slots[index] >= 0 || wakeTimes[index] != event.time) continue;
+        wakeTimes[index] = -1.0;
+        due.push_back(event);
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "EventQueue.h"
+
+// Splits an indexed population into awake and dormant members so per-tick
+// passes only visit the awake ones. Dormant members wake on explicit events
+// or on a scheduled wake time kept in a min-heap.
+class ActiveSet {
+public:
+    ActiveSet() {}
+    
+    void reset(size_t count);                   // everyone awake, no scheduled wakes
+    void erase(size_t index);                   // member removed, the last one moves into index
+    void swapMembers(size_t a, size_t b);       // mirrors a reorder of the population
+    size_t size() const { return slots.size(); }
+    
+    bool isAwake(size_t index) const { return slots[index] >= 0; }
+    const std::vector<size_t>& getActive() const { return active; }
+    size_t getDormantCount() const { return slots.size() - active.size(); }
+    
+    void wake(size_t index);
+    // wakeTime is absolute game time in seconds; negative means only events wake it
+    void sleep(size_t index, double wakeTime, SimEventType reason);
+    
+    // Moves every dormant member whose wake time has passed into due (still
+    // dormant - the caller decides whether to wake it or sleep it again)
+    void collectDue(double now, std::vector<SimEvent>& due);
+
+private:
+    std::vector<int> slots;         // index -> position in active, -1 when dormant
+    std::vector<size_t> active;     // awake members, unordered
+    std::vector<double> wakeTimes;  // scheduled wake per dormant member, -1 for none
+    std::vector<SimEventType> wakeReasons;
+    EventQueue wakes;               // may hold stale entries, checked against wakeTimes
+    
+    void removeActive(size_t index);
+    void queueWake(size_t index);
+};
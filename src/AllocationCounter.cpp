@@ -0,0 +1,87 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Replaces the global allocation functions. Counting is a couple of relaxed
+// increments, cheap enough to leave on in every build.
+
+static std::atomic<long long> totalCount(0);
+static std::atomic<long long> totalBytes(0);
+static thread_local long long threadCount = 0;
+static thread_local long long threadBytes = 0;
+
+static void recordAllocation(size_t size) {
+    totalCount.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    threadCount++;
+    threadBytes += static_cast<long long>(size);
+}
+
+static void* allocateBlock(size_t size) {
+    recordAllocation(size);
+    void* block = std::malloc(size ? size : 1);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+
+static void* allocateAligned(size_t size, size_t alignment) {
+    recordAllocation(size);
+#ifdef _WIN32
+    void* block = _aligned_malloc(size ? size : 1, alignment);
+#else
+    // aligned_alloc wants the size to be a multiple of the alignment
+    size_t rounded = (size + alignment - 1) / alignment * alignment;
+    void* block = std::aligned_alloc(alignment, rounded ? rounded : alignment);
+#endif
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+
+static void freeAligned(void* block) {
+#ifdef _WIN32
+    _aligned_free(block);
+#else
+    std::free(block);
+#endif
+}
+
+AllocationStats processAllocations() {
+    return AllocationStats(totalCount.load(std::memory_order_relaxed),
+                           totalBytes.load(std::memory_order_relaxed));
+}
+
+AllocationStats threadAllocations() {
+    return AllocationStats(threadCount, threadBytes);
+}
+
+void* operator new(size_t size) { return allocateBlock(size); }
+void* operator new[](size_t size) { return allocateBlock(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    recordAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    recordAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, size_t) noexcept { std::free(block); }
+void operator delete[](void* block, size_t) noexcept { std::free(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { std::free(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { std::free(block); }
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, static_cast<size_t>(alignment));
+}
+void operator delete(void* block, std::align_val_t) noexcept { freeAligned(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { freeAligned(block); }
+void operator delete(void* block, size_t, std::align_val_t) noexcept { freeAligned(block); }
+void operator delete[](void* block, size_t, std::align_val_t) noexcept { freeAligned(block); }
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+
+// Heap allocations made through the global operator new. The process-wide
+// totals cover every thread; the per-thread totals let a task measure only
+// its own work while others run alongside it.
+struct AllocationStats {
+    long long count;
+    long long bytes;
+    
+    AllocationStats() : count(0), bytes(0) {}
+    AllocationStats(long long count, long long bytes) : count(count), bytes(bytes) {}
+    
+    AllocationStats operator-(const AllocationStats& start) const {
+        return AllocationStats(count - start.count, bytes - start.bytes);
+    }
+};
+
+AllocationStats processAllocations();
+AllocationStats threadAllocations();
@@ -0,0 +1,85 @@
+#pragma once
+#include "Enemy.h"
+#include "Weapon.h"
+#include <cstddef>
+
+// Immutable per-type data shared by every instance. Units and weapons keep
+// only their type, which indexes these tables, plus their mutable state.
+
+struct EnemyArchetype {
+    EnemyType type;
+    const char* name;
+    int maxHealth;
+    int minDamage;
+    int maxDamage;
+    double moveSpeed;           // km/h
+    EnemyCapabilities capabilities;
+};
+
+struct WeaponArchetype {
+    WeaponType type;
+    const char* name;
+    GuidanceType guidance;
+    int minDamage;
+    int maxDamage;
+    int ammoCapacity;
+    WeaponSpecs specs;
+    uint32_t effectiveTargets;  // enemyTypeBit mask
+};
+
+// In EnemyType order. Capabilities: detection km, engagement km, max speed km/h,
+// armor, radar, airborne, mobile.
+inline constexpr EnemyArchetype ENEMY_ARCHETYPES[] = {
+    { EnemyType::SCOUT_DRONE,       "Scout Drone",        30,  5, 15,  80.0, { 8.0,  3.0,  80.0, 0.1, true,  true,  true  } },
+    { EnemyType::ATTACK_DRONE,      "Attack Drone",       50, 10, 25,  60.0, { 6.0,  4.0,  60.0, 0.2, true,  true,  true  } },
+    { EnemyType::LIGHT_TANK,        "Light Tank",         80, 15, 25,  40.0, { 4.0,  4.5,  40.0, 0.3, false, false, true  } },
+    { EnemyType::HEAVY_TANK,        "Heavy Tank",        180, 35, 50,  25.0, { 4.0,  8.0,  25.0, 0.6, false, false, true  } },
+    { EnemyType::SAM_SITE,          "SAM Site",           60, 25, 45,   0.0, { 10.0, 8.0,   0.0, 0.2, true,  false, false } },
+    { EnemyType::FIGHTER_JET,       "Fighter Jet",       120, 45, 80, 500.0, { 20.0, 15.0, 500.0, 0.2, true,  true,  true  } },
+    { EnemyType::ATTACK_HELICOPTER, "Attack Helicopter",  90, 25, 45, 200.0, { 10.0, 8.0, 200.0, 0.3, true,  true,  true  } },
+    { EnemyType::MOBILE_AAA,        "Mobile AAA",         70, 15, 30,  35.0, { 8.0,  6.0,  35.0, 0.3, true,  false, true  } },
+};
+
+// Target sets for WeaponArchetype::effectiveTargets
+inline constexpr uint32_t AIR_TARGETS = enemyTypeBit(EnemyType::SCOUT_DRONE) | enemyTypeBit(EnemyType::ATTACK_DRONE) |
+                                        enemyTypeBit(EnemyType::FIGHTER_JET) | enemyTypeBit(EnemyType::ATTACK_HELICOPTER);
+inline constexpr uint32_t GROUND_TARGETS = enemyTypeBit(EnemyType::LIGHT_TANK) | enemyTypeBit(EnemyType::HEAVY_TANK) |
+                                           enemyTypeBit(EnemyType::SAM_SITE) | enemyTypeBit(EnemyType::MOBILE_AAA);
+inline constexpr uint32_t LIGHT_TARGETS = enemyTypeBit(EnemyType::SCOUT_DRONE) | enemyTypeBit(EnemyType::ATTACK_DRONE) |
+                                          enemyTypeBit(EnemyType::LIGHT_TANK);
+inline constexpr uint32_t ALL_TARGETS = AIR_TARGETS | GROUND_TARGETS;
+
+// In WeaponType order, the default Apache loadout. Specs: range km, lock-on s,
+// reload s, accuracy, line of sight, penetration, blast radius m.
+inline constexpr WeaponArchetype WEAPON_ARCHETYPES[] = {
+    { WeaponType::AIR_TO_AIR_MISSILE,    "AIM-9 Sidewinder", GuidanceType::INFRARED, 55,  85,    4, { 15.0, 3.0, 4.0, 0.88, true, 60.0,  8.0 }, AIR_TARGETS },
+    { WeaponType::AIR_TO_GROUND_MISSILE, "Hellfire Missile", GuidanceType::LASER,    80, 120,    8, {  8.0, 2.0, 3.0, 0.90, true, 80.0, 10.0 }, GROUND_TARGETS },
+    { WeaponType::MACHINE_GUN,           "M134 Minigun",     GuidanceType::NONE,      8,  15, 2000, {  2.0, 0.0, 0.5, 0.80, true, 15.0,  0.0 }, LIGHT_TARGETS },
+    { WeaponType::ROCKET_POD,            "Hydra 70 Rockets", GuidanceType::NONE,     35,  55,   38, {  5.0, 0.0, 2.0, 0.75, true, 50.0, 15.0 }, ALL_TARGETS },
+    { WeaponType::CANNON,                "M230 Chain Gun",   GuidanceType::NONE,     15,  25, 1200, {  3.0, 0.0, 1.0, 0.85, true, 25.0,  0.0 }, LIGHT_TARGETS },
+    { WeaponType::GUIDED_MISSILE,        "TOW Missile",      GuidanceType::RADAR,    90, 130,    6, { 20.0, 4.0, 5.0, 0.95, true, 90.0, 12.0 }, ALL_TARGETS },
+    { WeaponType::UNGUIDED_ROCKET,       "Zuni Rockets",     GuidanceType::NONE,     30,  50,   12, {  4.0, 0.0, 2.5, 0.70, true, 40.0, 12.0 }, ALL_TARGETS },
+};
+
+template <typename Archetype, size_t Count>
+constexpr bool archetypesInOrder(const Archetype (&table)[Count]) {
+    for (size_t i = 0; i < Count; ++i) {
+        if (static_cast<size_t>(table[i].type) != i) return false;
+    }
+    return true;
+}
+
+static_assert(archetypesInOrder(ENEMY_ARCHETYPES), "ENEMY_ARCHETYPES must follow EnemyType order");
+static_assert(sizeof(ENEMY_ARCHETYPES) / sizeof(ENEMY_ARCHETYPES[0]) == ENEMY_TYPE_COUNT,
+              "one archetype per EnemyType");
+static_assert(archetypesInOrder(WEAPON_ARCHETYPES), "WEAPON_ARCHETYPES must follow WeaponType order");
+static_assert(sizeof(WEAPON_ARCHETYPES) / sizeof(WEAPON_ARCHETYPES[0]) ==
+              static_cast<size_t>(WeaponType::UNGUIDED_ROCKET) + 1, "one archetype per WeaponType");
+
+inline const EnemyArchetype& enemyArchetype(EnemyType type) {
+    return ENEMY_ARCHETYPES[static_cast<size_t>(type)];
+}
+
+inline const WeaponArchetype& weaponArchetype(WeaponType type) {
+    return WEAPON_ARCHETYPES[static_cast<size_t>(type)];
+}
@@ -0,0 +1,244 @@
+#include "BatchRunner.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+// Ticks before the allocation check starts - scratch buffers and the
+// snapshot pool reach their working size during the first few
+static const long long ALLOCATION_WARMUP_TICKS = 10;
+
+BatchRunner::BatchRunner(const BatchOptions& options)
+    : options(options), raceViolations(0), steadyTicks(0), allocatingTicks(0) {}
+
+void BatchRunner::showUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--batch scenario.cfg [--runs N] [--seed S] [--out results.jsonl] [--threads N] [--check-races] [--check-allocations] [--double-buffer] [--no-lod] [--no-dormancy] [--no-spatial-order]]" << std::endl;
+    std::cerr << "  --batch FILE   Run missions headless using the scenario file" << std::endl;
+    std::cerr << "  --runs N       Number of missions to run (default 1)" << std::endl;
+    std::cerr << "  --seed S       Base random seed, run i uses S + i (default 1)" << std::endl;
+    std::cerr << "  --out FILE     Write JSON lines to FILE instead of stdout" << std::endl;
+    std::cerr << "  --threads N    Worker threads for the tick phases (default 0)" << std::endl;
+    std::cerr << "  --check-races  Report tick phases touching undeclared or contended state" << std::endl;
+    std::cerr << "  --check-allocations  Fail if an in-flight tick allocates once warmed up" << std::endl;
+    std::cerr << "  --double-buffer  Tick phases read the previous tick and write the next" << std::endl;
+    std::cerr << "  --no-lod       Update every enemy every tick regardless of distance" << std::endl;
+    std::cerr << "  --no-dormancy  Keep idle enemies in every tick instead of sleeping them" << std::endl;
+    std::cerr << "  --no-spatial-order  Leave enemies in spawn order instead of re-sorting by position" << std::endl;
+    std::cerr << "Reports: " << program << " --scaling-report UNITS [--threads N] | --layout-report UNITS | --detection-report | --math-report" << std::endl;
+    std::cerr << "  --scaling-report UNITS  Time the enemy update on 1..N threads (default all cores)" << std::endl;
+    std::cerr << "  --layout-report UNITS   Memory per unit and single-thread update/scan cost" << std::endl;
+    std::cerr << "  --detection-report      Batched radar detection against the scalar path" << std::endl;
+    std::cerr << "  --math-report           Math kernels on every instruction set the CPU supports" << std::endl;
+}
+
+bool BatchRunner::parseArguments(int argc, char* argv[], BatchOptions& options) {
+    // Batch-only flags, checked once --batch has had its chance to appear
+    const char* batchFlag = nullptr;
+    const char* threadsFlag = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        bool batchOnly = true;
+        
+        if (std::strcmp(arg, "--batch") == 0 && hasValue) {
+            batchOnly = false;
+            options.enabled = true;
+            options.scenarioFile = argv[++i];
+        } else if (std::strcmp(arg, "--runs") == 0 && hasValue) {
+            options.runs = std::atoi(argv[++i]);
+            if (options.runs <= 0) {
+                std::cerr << "--runs must be a positive number" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            options.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--out") == 0 && hasValue) {
+            options.outputFile = argv[++i];
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            // Also sizes the scaling report
+            batchOnly = false;
+            threadsFlag = arg;
+            options.threads = std::atoi(argv[++i]);
+            if (options.threads < 0) {
+                std::cerr << "--threads must not be negative" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--check-races") == 0) {
+            options.checkRaces = true;
+        } else if (std::strcmp(arg, "--check-allocations") == 0) {
+            options.checkAllocations = true;
+        } else if (std::strcmp(arg, "--double-buffer") == 0) {
+            options.doubleBuffer = true;
+        } else if (std::strcmp(arg, "--no-lod") == 0) {
+            options.levelOfDetail = false;
+        } else if (std::strcmp(arg, "--no-dormancy") == 0) {
+            options.dormancy = false;
+        } else if (std::strcmp(arg, "--no-spatial-order") == 0) {
+            options.spatialOrder = false;
+        } else if (std::strcmp(arg, "--scaling-report") == 0 && hasValue) {
+            batchOnly = false;
+            long units = std::atol(argv[++i]);
+            if (units <= 0) {
+                std::cerr << "--scaling-report needs a positive unit count" << std::endl;
+                return false;
+            }
+            options.scalingUnits = static_cast<size_t>(units);
+        } else if (std::strcmp(arg, "--layout-report") == 0 && hasValue) {
+            batchOnly = false;
+            long units = std::atol(argv[++i]);
+            if (units <= 0) {
+                std::cerr << "--layout-report needs a positive unit count" << std::endl;
+                return false;
+            }
+            options.layoutUnits = static_cast<size_t>(units);
+        } else if (std::strcmp(arg, "--detection-report") == 0) {
+            batchOnly = false;
+            options.detectionReport = true;
+        } else if (std::strcmp(arg, "--math-report") == 0) {
+            batchOnly = false;
+            options.mathReport = true;
+        } else {
+            std::cerr << "Unknown or incomplete argument: " << arg << std::endl;
+            showUsage(argv[0]);
+            return false;
+        }
+        if (batchOnly && !batchFlag) {
+            batchFlag = arg;
+        }
+    }
+    
+    // Without --batch these would silently fall through to the interactive
+    // menu, which a pipeline would then hang on
+    if (!options.enabled && !batchFlag && options.scalingUnits == 0) {
+        batchFlag = threadsFlag;
+    }
+    if (!options.enabled && batchFlag) {
+        std::cerr << batchFlag << " needs --batch" << std::endl;
+        showUsage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+int BatchRunner::run() {
+    std::string error;
+    if (!loadScenario(options.scenarioFile, scenario, error)) {
+        std::cerr << "Scenario error: " << error << std::endl;
+        return 1;
+    }
+    
+    std::ofstream file;
+    if (!options.outputFile.empty()) {
+        file.open(options.outputFile);
+        if (!file) {
+            std::cerr << "Cannot open output file '" << options.outputFile << "'" << std::endl;
+            return 1;
+        }
+    }
+    
+    // Game code reports through std::cout; silence it so console I/O does not
+    // dominate batch throughput. Results go to the file or a restored stdout.
+    std::streambuf* consoleBuffer = std::cout.rdbuf();
+    std::ostream out(options.outputFile.empty() ? consoleBuffer : file.rdbuf());
+    std::cout.rdbuf(nullptr);
+    
+    raceViolations = 0;
+    steadyTicks = 0;
+    allocatingTicks = 0;
+    firstAllocation.clear();
+    auto batchStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.runs; ++i) {
+        unsigned int seed = options.seed + static_cast<unsigned int>(i);
+        auto runStart = std::chrono::steady_clock::now();
+        MissionResult result = runMission(seed);
+        std::chrono::duration<double> wall = std::chrono::steady_clock::now() - runStart;
+        writeResult(out, i, seed, result, wall.count());
+    }
+    std::chrono::duration<double> total = std::chrono::steady_clock::now() - batchStart;
+    
+    std::cout.clear();
+    std::cout.rdbuf(consoleBuffer);
+    out.flush();
+    
+    double runsPerHour = total.count() > 0.0 ? options.runs * 3600.0 / total.count() : 0.0;
+    std::cerr << "Completed " << options.runs << " runs in " << std::fixed << std::setprecision(3)
+              << total.count() << "s (" << std::setprecision(0) << runsPerHour << " runs/hour)" << std::endl;
+    int exitCode = 0;
+    if (options.checkRaces) {
+        std::cerr << "Race check: " << raceViolations << " violations" << std::endl;
+        if (raceViolations > 0) exitCode = 1;
+    }
+    if (options.checkAllocations) {
+        std::cerr << "Allocation check: " << allocatingTicks << " of " << steadyTicks
+                  << " steady-state ticks allocated" << std::endl;
+        if (allocatingTicks > 0) {
+            std::cerr << "  first: " << firstAllocation << std::endl;
+            exitCode = 1;
+        }
+    }
+    return exitCode;
+}
+
+MissionResult BatchRunner::runMission(unsigned int seed) {
+    Game game;
+    // Nobody observes batch runs, but the allocation check covers the interactive tick
+    game.setSnapshotPublishing(options.checkAllocations);
+    game.setWorkerThreads(options.threads);
+    game.setRaceChecking(options.checkRaces);
+    game.setDoubleBuffering(options.doubleBuffer);
+    game.setLodEnabled(options.levelOfDetail);
+    game.setDormancyEnabled(options.dormancy);
+    game.setSpatialOrdering(options.spatialOrder);
+    game.startHeadlessMission(scenario, seed);
+    long long ticks = 0;
+    while (!game.isSimulationFinished()) {
+        game.stepSimulation();
+        if (options.checkAllocations && ++ticks > ALLOCATION_WARMUP_TICKS &&
+            game.getGameState() == GameState::IN_FLIGHT) {
+            checkTickAllocations(game, seed, ticks);
+        }
+    }
+    raceViolations += game.getRaceViolations();
+    return game.getMissionResult();
+}
+
+void BatchRunner::checkTickAllocations(const Game& game, unsigned int seed, long long tick) {
+    steadyTicks++;
+    const AllocationStats& stats = game.getTickAllocations();
+    if (stats.count == 0) return;
+    
+    if (allocatingTicks++ == 0) {
+        std::ostringstream where;
+        where << "seed " << seed << " tick " << tick << ", " << stats.count << " allocations ("
+              << stats.bytes << " bytes)";
+        const TaskGraph& graph = game.getTickGraph();
+        for (int i = 0; i < static_cast<int>(graph.getTaskCount()); ++i) {
+            if (graph.getTaskAllocations(i).count > 0) {
+                where << ", phase '" << graph.getTaskName(i) << "' " << graph.getTaskAllocations(i).count;
+            }
+        }
+        firstAllocation = where.str();
+    }
+}
+
+void BatchRunner::writeResult(std::ostream& out, int runIndex, unsigned int seed,
+                              const MissionResult& result, double wallSeconds) const {
+    out << std::fixed << std::setprecision(3)
+        << "{\"run\":" << runIndex
+        << ",\"seed\":" << seed
+        << ",\"mission\":\"" << missionTypeName(result.missionType) << "\""
+        << ",\"status\":\"" << missionStatusName(result.status) << "\""
+        << ",\"score\":" << result.score
+        << ",\"rating\":\"" << result.rating << "\""
+        << ",\"sim_time\":" << result.simTime
+        << ",\"ticks\":" << result.ticks
+        << ",\"enemies_destroyed\":" << result.enemiesDestroyed
+        << ",\"enemies_remaining\":" << result.enemiesRemaining
+        << ",\"helicopter_health\":" << result.helicopterHealth
+        << ",\"fuel\":" << result.fuelRemaining
+        << ",\"wall_time\":" << wallSeconds
+        << "}\n";
+}
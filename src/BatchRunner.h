@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <ostream>
+#include "Game.h"
+#include "Scenario.h"
+
+// Command-line options for non-interactive runs
+struct BatchOptions {
+    bool enabled;
+    std::string scenarioFile;
+    int runs;
+    unsigned int seed;
+    std::string outputFile;     // empty = stdout
+    int threads;                // tick phase workers per run, max threads for reports
+    bool checkRaces;
+    bool checkAllocations;      // fail if a steady-state tick touches the heap
+    bool doubleBuffer;
+    bool levelOfDetail;         // tiered enemy updates by distance
+    bool dormancy;              // idle enemies sleep until woken
+    bool spatialOrder;          // large populations re-sorted along a space-filling curve
+    size_t scalingUnits;        // > 0 runs the enemy update scaling report instead
+    size_t layoutUnits;         // > 0 runs the enemy memory layout report instead
+    bool detectionReport;       // runs the radar detection kernel report instead
+    bool mathReport;            // runs the math kernel report instead
+
+    BatchOptions() : enabled(false), runs(1), seed(1), threads(0), checkRaces(false), checkAllocations(false),
+                     doubleBuffer(false), levelOfDetail(true), dormancy(true), spatialOrder(true),
+                     scalingUnits(0), layoutUnits(0), detectionReport(false), mathReport(false) {}
+};
+
+class BatchRunner {
+public:
+    explicit BatchRunner(const BatchOptions& options);
+    
+    // Parses argv. Returns false (and prints usage) on malformed arguments.
+    static bool parseArguments(int argc, char* argv[], BatchOptions& options);
+    static void showUsage(const char* program);
+    
+    // Runs every mission and writes one JSON record per line. Returns the process exit code.
+    int run();
+
+private:
+    BatchOptions options;
+    ScenarioConfig scenario;
+    int raceViolations;
+    long long steadyTicks;          // ticks checked for allocations
+    long long allocatingTicks;
+    std::string firstAllocation;    // where the first allocating tick was seen
+    
+    MissionResult runMission(unsigned int seed);
+    void checkTickAllocations(const Game& game, unsigned int seed, long long tick);
+    void writeResult(std::ostream& out, int runIndex, unsigned int seed,
+                     const MissionResult& result, double wallSeconds) const;
+};
@@ -0,0 +1,571 @@
+#include "Benchmarks.h"
+#include "Game.h"
+#include "Snapshot.h"
+#include "SpatialOrder.h"
+#include "SpatialGrid.h"
+#include "ZoneIndex.h"
+#include "DetectionKernel.h"
+#include "MathKernels.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <algorithm>
+#include <string>
+
+static const EnemyType benchmarkTypes[] = {
+    EnemyType::SCOUT_DRONE, EnemyType::ATTACK_DRONE, EnemyType::LIGHT_TANK,
+    EnemyType::HEAVY_TANK, EnemyType::ATTACK_HELICOPTER, EnemyType::MOBILE_AAA
+};
+
+// Large battle spread over a 100 km square, every unit patrolling a box and
+// one in eight alerted so the AI timers run as well.
+static EnemyStore createBattle(size_t enemyCount) {
+    EnemyStore enemies;
+    enemies.reserve(enemyCount);
+    for (size_t i = 0; i < enemyCount; ++i) {
+        double x = static_cast<double>(i % 1000) * 0.1 - 50.0;
+        double y = static_cast<double>(i / 1000 % 1000) * 0.1 - 50.0;
+        EnemyType type = benchmarkTypes[i % (sizeof(benchmarkTypes) / sizeof(benchmarkTypes[0]))];
+        Enemy enemy = enemies.add(type, EnemyPosition(x, y, 0.0));
+        enemy.setId(FIRST_ENEMY_ENTITY + static_cast<EntityId>(i));
+        
+        std::vector<EnemyPosition> route;
+        route.push_back(EnemyPosition(x + 2.0, y, 0.0));
+        route.push_back(EnemyPosition(x + 2.0, y + 2.0, 0.0));
+        route.push_back(EnemyPosition(x, y + 2.0, 0.0));
+        route.push_back(EnemyPosition(x, y, 0.0));
+        enemy.setPatrolRoute(route);
+        
+        if (i % 8 == 0) {
+            enemy.reactToThreat(EnemyPosition(0.0, 0.0, 500.0));
+        }
+    }
+    return enemies;
+}
+
+static bool sameState(const EnemyView& a, const EnemyView& b) {
+    EnemySnapshot first, second;
+    a.fillSnapshot(first);
+    b.fillSnapshot(second);
+    return std::memcmp(&first.position, &second.position, sizeof(EnemyPosition)) == 0
+        && first.health == second.health
+        && first.behavior == second.behavior
+        && a.getTimeToAlertTimeout() == b.getTimeToAlertTimeout()
+        && a.getTimeToNextWaypoint() == b.getTimeToNextWaypoint();
+}
+
+int runEnemyScalingReport(size_t enemyCount, int maxThreads, int ticks) {
+    if (maxThreads <= 0) {
+        maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    const double dt = 0.05;
+    
+    EnemyStore reference = createBattle(enemyCount);
+    const EnemyStore initial = reference;
+    
+    std::cout << "Enemy update scaling: " << enemyCount << " units, " << ticks << " ticks" << std::endl;
+    std::cout << std::left << std::setw(10) << "Threads" << std::setw(14) << "ms/tick"
+              << std::setw(10) << "Speedup" << std::setw(10) << "Steals" << "Result" << std::endl;
+    
+    double serialMs = 0.0;
+    bool allIdentical = true;
+    for (int threads = 1; threads <= maxThreads; ++threads) {
+        EnemyStore enemies = initial;
+        ThreadPool pool(threads - 1); // the calling thread is the last worker
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < ticks; ++tick) {
+            Game::updateEnemyPopulation(enemies, dt, &pool);
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        double msPerTick = elapsed.count() / ticks;
+        
+        bool identical = true;
+        if (threads == 1) {
+            serialMs = msPerTick;
+            reference = enemies;
+        } else {
+            for (size_t i = 0; i < enemies.size() && identical; ++i) {
+                identical = sameState(enemies[i], reference[i]);
+            }
+        }
+        allIdentical = allIdentical && identical;
+        
+        std::cout << std::left << std::setw(10) << threads
+                  << std::setw(14) << std::fixed << std::setprecision(3) << msPerTick
+                  << std::setw(10) << std::setprecision(2) << (msPerTick > 0.0 ? serialMs / msPerTick : 0.0)
+                  << std::setw(10) << pool.getStealCount()
+                  << (threads == 1 ? "reference" : (identical ? "identical" : "MISMATCH")) << std::endl;
+    }
+    
+    // Double-buffered ticks must land on the same state as in-place updates
+    {
+        EnemyStore current = initial;
+        EnemyStore next = initial;
+        ThreadPool pool(maxThreads - 1);
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < ticks; ++tick) {
+            Game::advanceEnemyPopulation(current, next, dt, &pool);
+            current.swap(next);
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        double msPerTick = elapsed.count() / ticks;
+        
+        bool identical = true;
+        for (size_t i = 0; i < current.size() && identical; ++i) {
+            identical = sameState(current[i], reference[i]);
+        }
+        allIdentical = allIdentical && identical;
+        
+        std::cout << std::left << std::setw(10) << (std::to_string(maxThreads) + "x2buf")
+                  << std::setw(14) << std::fixed << std::setprecision(3) << msPerTick
+                  << std::setw(10) << std::setprecision(2) << (msPerTick > 0.0 ? serialMs / msPerTick : 0.0)
+                  << std::setw(10) << pool.getStealCount()
+                  << (identical ? "identical" : "MISMATCH") << std::endl;
+    }
+    
+    return allIdentical ? 0 : 1;
+}
+
+// Scatters units through memory, as spawn order and kills do in a long battle
+static void shuffleUnits(EnemyStore& enemies) {
+    unsigned long long state = 12345;
+    for (size_t i = enemies.size(); i-- > 1;) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        enemies.swapUnits(i, static_cast<size_t>((state >> 33) % (i + 1)));
+    }
+}
+
+// Average ns per pass of reading a few columns of every unit in Morton order
+static double timeCurveWalk(const EnemyStore& enemies, int passes) {
+    std::vector<std::pair<uint32_t, uint32_t>> visit(enemies.size());
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        const EnemyPosition& pos = enemies[i].getPosition();
+        visit[i] = std::make_pair(mortonKey(pos.x, pos.y), static_cast<uint32_t>(i));
+    }
+    std::sort(visit.begin(), visit.end());
+    
+    double checksum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& entry : visit) {
+            const EnemyView enemy = enemies[entry.second];
+            checksum += enemy.getPosition().x + enemy.getHealth() + enemy.getLodState().pendingTime;
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (checksum == -1.0) std::cout << "";   // keeps the reads from being optimised away
+    return elapsed.count() / passes;
+}
+
+int runEnemyLayoutReport(size_t enemyCount, int ticks) {
+    const double dt = 0.05;
+    EnemyStore enemies = createBattle(enemyCount);
+    double units = static_cast<double>(enemyCount);
+    
+    std::cout << "Enemy layout: " << enemyCount << " units, " << ticks << " ticks" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Memory:       " << enemies.memoryUsage() / units << " bytes/unit ("
+              << EnemyStore::hotBytesPerUnit() << " in hot columns)" << std::endl;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        Game::updateEnemyPopulation(enemies, dt, nullptr);
+    }
+    std::chrono::duration<double, std::nano> updateTime = std::chrono::steady_clock::now() - start;
+    
+    // Nearest unit and units in detection range of a point, the shape of
+    // the radar and wake-up queries
+    size_t nearest = 0;
+    size_t inRange = 0;
+    start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        double best = 0.0;
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            const Enemy enemy = enemies[i];
+            const EnemyPosition& pos = enemy.getPosition();
+            double distanceSq = pos.x * pos.x + pos.y * pos.y;
+            if (i == 0 || distanceSq < best) {
+                best = distanceSq;
+                nearest = i;
+            }
+            double range = enemy.getDetectionRange();
+            if (distanceSq <= range * range) {
+                ++inRange;
+            }
+        }
+    }
+    std::chrono::duration<double, std::nano> scanTime = std::chrono::steady_clock::now() - start;
+    
+    // Kill and respawn units spread through the population, the cost of
+    // each should not depend on how many units there are
+    const size_t churn = std::min<size_t>(enemyCount, 10000);
+    start = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < churn; ++k) {
+        size_t index = (k * 7919) % enemies.size();
+        EnemyPosition pos = enemies[index].getPosition();
+        enemies.erase(index);
+        enemies.add(EnemyType::LIGHT_TANK, pos);
+    }
+    std::chrono::duration<double, std::nano> churnTime = std::chrono::steady_clock::now() - start;
+    
+    // Alerted air units within AIM-9 range of a unit mid-battle, answered
+    // from the secondary indexes and by scanning every unit; the two must agree
+    const EnemyPosition center = enemies[enemies.size() / 2].getPosition();
+    EnemyFilter filter;
+    filter.required |= ENEMY_ALERTED | ENEMY_AIRBORNE;
+    filter.within(center.x, center.y, 15.0);
+    std::vector<size_t> matches;
+    std::vector<size_t> scanned;
+    matches.reserve(enemies.size());
+    scanned.reserve(enemies.size());
+    start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        enemies.select(filter, matches);
+    }
+    std::chrono::duration<double, std::nano> indexedTime = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        scanned.clear();
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            const Enemy enemy = enemies[i];
+            if (!enemy.isAlive() || !enemy.isOnAlert() || !enemy.isAirTarget()) continue;
+            double dx = enemy.getPosition().x - center.x;
+            double dy = enemy.getPosition().y - center.y;
+            if (dx * dx + dy * dy <= 15.0 * 15.0) {
+                scanned.push_back(i);
+            }
+        }
+    }
+    std::chrono::duration<double, std::nano> filterScanTime = std::chrono::steady_clock::now() - start;
+    if (matches != scanned) {
+        std::cout << "Query mismatch: index found " << matches.size() << ", scan found "
+                  << scanned.size() << std::endl;
+        return 1;
+    }
+    
+    // Detection-sized radius and nearest-ten queries from the spatial grid,
+    // checked against brute force; the grid keeps up with one tick of
+    // movement per refresh
+    SpatialGrid grid;
+    grid.update(enemies);
+    std::chrono::duration<double, std::micro> refreshTime(0.0);
+    std::chrono::duration<double, std::nano> radiusTime(0.0);
+    std::chrono::duration<double, std::nano> radiusScanTime(0.0);
+    std::vector<size_t> closest;
+    std::vector<size_t> inRadius;
+    std::vector<size_t> scannedRadius;
+    inRadius.reserve(enemies.size());
+    scannedRadius.reserve(enemies.size());
+    bool gridAgrees = true;
+    for (int tick = 0; tick < ticks; ++tick) {
+        Game::updateEnemyPopulation(enemies, dt, nullptr);
+        grid.invalidate();
+        start = std::chrono::steady_clock::now();
+        grid.update(enemies);
+        refreshTime += std::chrono::steady_clock::now() - start;
+        
+        const EnemyPosition& probe = enemies[(static_cast<size_t>(tick) * 7919) % enemies.size()].getPosition();
+        start = std::chrono::steady_clock::now();
+        grid.queryRadius(probe.x, probe.y, 2.0, inRadius);
+        radiusTime += std::chrono::steady_clock::now() - start;
+        start = std::chrono::steady_clock::now();
+        scannedRadius.clear();
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            double dx = enemies[i].getPosition().x - probe.x;
+            double dy = enemies[i].getPosition().y - probe.y;
+            if (dx * dx + dy * dy <= 2.0 * 2.0) scannedRadius.push_back(i);
+        }
+        radiusScanTime += std::chrono::steady_clock::now() - start;
+        gridAgrees = gridAgrees && inRadius == scannedRadius;
+        
+        // Nearest ten: nobody outside the set may be closer than its farthest
+        grid.queryNearest(probe.x, probe.y, 10, closest);
+        const EnemyPosition& farthest = enemies[closest.back()].getPosition();
+        double limit = (farthest.x - probe.x) * (farthest.x - probe.x) + (farthest.y - probe.y) * (farthest.y - probe.y);
+        size_t closer = 0;
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            double dx = enemies[i].getPosition().x - probe.x;
+            double dy = enemies[i].getPosition().y - probe.y;
+            if (dx * dx + dy * dy < limit) closer++;
+        }
+        gridAgrees = gridAgrees && closest.size() == std::min<size_t>(10, enemies.size()) && closer < closest.size();
+    }
+    if (!gridAgrees) {
+        std::cout << "Spatial grid disagrees with brute force" << std::endl;
+        return 1;
+    }
+    
+    // Engagement envelopes of the whole battle, rebuilt each tick they are used
+    ZoneIndex envelopes;
+    start = std::chrono::steady_clock::now();
+    envelopes.update(enemies);
+    std::chrono::duration<double, std::milli> envelopeBuildTime = std::chrono::steady_clock::now() - start;
+    
+    // Zones as a theatre has them, one per unit about 20 km apart with 2-10 km
+    // radii: which cover a point, and which a 100 km leg from it crosses
+    ZoneIndex zones;
+    double side = std::sqrt(static_cast<double>(units)) * 20.0;
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        double x = static_cast<double>(state >> 40) / (1 << 24) * side;
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        double y = static_cast<double>(state >> 40) / (1 << 24) * side;
+        zones.add(Zone(x, y, 2.0 + static_cast<double>(i % 9), i % 3 == 0 ? ZONE_NO_FLY : ZONE_THREAT));
+    }
+    zones.build();
+    
+    std::chrono::duration<double, std::nano> pointTime(0), pointScanTime(0), legTime(0), legScanTime(0);
+    std::vector<size_t> covering, scannedCovering, crossed, scannedCrossed;
+    size_t coveringTotal = 0, crossedTotal = 0;
+    bool zonesAgree = true;
+    for (int tick = 0; tick < ticks; ++tick) {
+        const Zone& probe = zones[(static_cast<size_t>(tick) * 7919) % zones.size()];
+        double x0 = probe.x + 1.0, y0 = probe.y + 1.0;
+        double x1 = x0 + 80.0, y1 = y0 + 60.0;
+        
+        start = std::chrono::steady_clock::now();
+        zones.queryPoint(x0, y0, ZONE_ANY, covering);
+        pointTime += std::chrono::steady_clock::now() - start;
+        start = std::chrono::steady_clock::now();
+        scannedCovering.clear();
+        for (size_t i = 0; i < zones.size(); ++i) {
+            double dx = x0 - zones[i].x;
+            double dy = y0 - zones[i].y;
+            if (dx * dx + dy * dy < zones[i].radius * zones[i].radius) scannedCovering.push_back(i);
+        }
+        pointScanTime += std::chrono::steady_clock::now() - start;
+        
+        start = std::chrono::steady_clock::now();
+        zones.querySegment(x0, y0, x1, y1, ZONE_ANY, crossed);
+        legTime += std::chrono::steady_clock::now() - start;
+        start = std::chrono::steady_clock::now();
+        scannedCrossed.clear();
+        for (size_t i = 0; i < zones.size(); ++i) {
+            const Zone& zone = zones[i];
+            double t = ((zone.x - x0) * (x1 - x0) + (zone.y - y0) * (y1 - y0)) / ((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0));
+            t = std::max(0.0, std::min(1.0, t));
+            double dx = x0 + t * (x1 - x0) - zone.x;
+            double dy = y0 + t * (y1 - y0) - zone.y;
+            if (dx * dx + dy * dy < zone.radius * zone.radius) scannedCrossed.push_back(i);
+        }
+        legScanTime += std::chrono::steady_clock::now() - start;
+        
+        zonesAgree = zonesAgree && covering == scannedCovering && crossed == scannedCrossed;
+        coveringTotal += covering.size();
+        crossedTotal += crossed.size();
+    }
+    if (!zonesAgree) {
+        std::cout << "Zone index disagrees with brute force" << std::endl;
+        return 1;
+    }
+    
+    // Visit units in curve order, the way a spatial query hands out
+    // neighbours - first scattered through memory, then after a re-sort
+    shuffleUnits(enemies);
+    double scatteredWalk = timeCurveWalk(enemies, ticks);
+    
+    // The first sort sizes the scratch; time the second, from scattered again
+    SpatialOrder order(4096, 0);
+    long long steps = 0;
+    double slowestStep = 0.0;
+    std::chrono::duration<double, std::micro> sortTime(0.0);
+    while (order.getCompletedSorts() < 2) {
+        if (order.getCompletedSorts() == 1 && !order.isSorting()) {
+            shuffleUnits(enemies);
+        }
+        bool timed = order.getCompletedSorts() == 1;
+        auto stepStart = std::chrono::steady_clock::now();
+        for (const auto& swap : order.step(enemies)) {
+            enemies.swapUnits(swap.first, swap.second);
+        }
+        std::chrono::duration<double, std::micro> stepTime = std::chrono::steady_clock::now() - stepStart;
+        if (timed) {
+            sortTime += stepTime;
+            slowestStep = std::max(slowestStep, stepTime.count());
+            ++steps;
+        }
+    }
+    double sortedWalk = timeCurveWalk(enemies, ticks);
+    
+    std::cout << std::setprecision(2);
+    std::cout << "Update:       " << updateTime.count() / (units * ticks) << " ns/unit" << std::endl;
+    std::cout << "Scan:         " << scanTime.count() / (units * ticks) << " ns/unit"
+              << " (nearest #" << nearest << ", " << inRange / ticks << " in range)" << std::endl;
+    std::cout << "Kill+spawn:   " << churnTime.count() / static_cast<double>(churn) << " ns" << std::endl;
+    std::cout << "Query:        " << indexedTime.count() / ticks / 1000.0 << " us indexed, "
+              << filterScanTime.count() / ticks / 1000.0 << " us scanned (" << matches.size()
+              << " alerted air units in 15 km)" << std::endl;
+    std::cout << "Envelopes:    " << envelopes.size() << " rebuilt in " << envelopeBuildTime.count() << " ms" << std::endl;
+    std::cout << "Zones:        point " << pointTime.count() / ticks / 1000.0 << " us indexed, "
+              << pointScanTime.count() / ticks / 1000.0 << " us scanned (" << coveringTotal / static_cast<double>(ticks)
+              << " cover it); 100 km leg " << legTime.count() / ticks / 1000.0 << " us indexed, "
+              << legScanTime.count() / ticks / 1000.0 << " us scanned (" << crossedTotal / static_cast<double>(ticks)
+              << " crossed)" << std::endl;
+    std::cout << "Radius 2 km:  " << radiusTime.count() / ticks / 1000.0 << " us grid, "
+              << radiusScanTime.count() / ticks / 1000.0 << " us scanned (" << inRadius.size()
+              << " units); refresh " << refreshTime.count() / ticks << " us/tick, "
+              << grid.getMoves() << " cell moves" << std::endl;
+    std::cout << "Curve walk:   " << scatteredWalk / units << " ns/unit scattered, "
+              << sortedWalk / units << " ns/unit sorted" << std::endl;
+    std::cout << "Re-sort:      " << steps << " steps of 4096 units, " << sortTime.count() / steps
+              << " us average, " << slowestStep << " us slowest" << std::endl;
+    return 0;
+}
+
+// Contacts scattered over a 200 km square around the radar, one in three airborne
+static void fillContacts(DetectionBatch& batch, size_t count) {
+    batch.clear();
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        double x = static_cast<double>(state >> 40) / (1 << 24) * 200.0 - 100.0;
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        double y = static_cast<double>(state >> 40) / (1 << 24) * 200.0 - 100.0;
+        batch.add(x, y, i % 3 == 0);
+    }
+}
+
+int runDetectionReport() {
+    static const size_t sizes[] = { 1000, 100000, 1000000 };
+    const RadarParameters radar = { 3.0, -2.0, 50.0, 0.9, 0.6 };
+    
+    std::cout << "Radar detection: " << detectionKernelName() << " kernel against scalar" << std::endl;
+    std::cout << std::left << std::setw(10) << "Contacts" << std::setw(14) << "scalar ns" << std::setw(14) << "kernel ns"
+              << std::setw(10) << "Speedup" << "Max bearing error" << std::endl;
+    
+    bool agrees = true;
+    DetectionBatch scalar, batched;
+    for (size_t count : sizes) {
+        fillContacts(scalar, count);
+        fillContacts(batched, count);
+        // About ten million contacts per timing whatever the batch size
+        int passes = static_cast<int>(std::max<size_t>(1, 10000000 / count));
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            detectContactsScalar(radar, scalar);
+        }
+        std::chrono::duration<double, std::nano> scalarTime = std::chrono::steady_clock::now() - start;
+        
+        start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            detectContacts(radar, batched);
+        }
+        std::chrono::duration<double, std::nano> kernelTime = std::chrono::steady_clock::now() - start;
+        
+        double bearingError = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            agrees = agrees && scalar.probabilities[i] == batched.probabilities[i]
+                            && scalar.ranges[i] == batched.ranges[i];
+            double error = std::fabs(scalar.bearings[i] - batched.bearings[i]);
+            bearingError = std::max(bearingError, std::min(error, 360.0 - error));
+        }
+        agrees = agrees && bearingError <= 1e-5;
+        
+        double scalarNs = scalarTime.count() / passes / count;
+        double kernelNs = kernelTime.count() / passes / count;
+        std::cout << std::left << std::setw(10) << count << std::fixed << std::setprecision(2)
+                  << std::setw(14) << scalarNs << std::setw(14) << kernelNs
+                  << std::setw(10) << scalarNs / kernelNs << std::scientific << std::setprecision(1)
+                  << bearingError << " deg" << std::defaultfloat << std::endl;
+    }
+    
+    if (!agrees) {
+        std::cout << "Detection kernel disagrees with the scalar path" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Times kernel over the inputs and returns ns per element
+template <typename Kernel>
+static double timeKernel(size_t count, Kernel kernel) {
+    const int passes = 10;
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        kernel();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / passes / count;
+}
+
+int runMathKernelReport() {
+    const size_t count = 1000000;
+    static const SimdLevel levels[] = { SimdLevel::SCALAR, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512 };
+    
+    // Offsets over a 200 km square and angles over a few turns either way
+    std::vector<double> x(count), y(count), radians(count), t(count);
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        x[i] = static_cast<double>(state >> 40) / (1 << 24) * 200.0 - 100.0;
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        y[i] = static_cast<double>(state >> 40) / (1 << 24) * 200.0 - 100.0;
+        radians[i] = (x[i] + y[i]) * 0.2;
+        t[i] = static_cast<double>(i % 1001) / 1000.0;
+    }
+    
+    std::cout << "Math kernels: " << count << " elements, selected " << mathKernels().name << std::endl;
+    std::cout << std::left << std::setw(10) << "Level" << std::setw(10) << "hypot" << std::setw(10) << "atan2"
+              << std::setw(10) << "sincos" << std::setw(10) << "clamp" << std::setw(10) << "lerp"
+              << std::setw(14) << "atan2 error" << std::setw(14) << "sincos error" << "Result" << std::endl;
+    
+    std::vector<double> ranges(count), angles(count), sines(count), cosines(count), clamped(count), mixed(count);
+    std::vector<double> firstRanges, firstAngles, firstSines, firstCosines, firstClamped, firstMixed;
+    bool allIdentical = true;
+    for (SimdLevel level : levels) {
+        const MathKernels* math = mathKernelsFor(level);
+        if (!math) continue;
+        
+        double hypotNs = timeKernel(count, [&] { math->hypot(x.data(), y.data(), ranges.data(), count); });
+        double atan2Ns = timeKernel(count, [&] { math->atan2(y.data(), x.data(), angles.data(), count); });
+        double sincosNs = timeKernel(count, [&] { math->sincos(radians.data(), sines.data(), cosines.data(), count); });
+        double clampNs = timeKernel(count, [&] { math->clamp(x.data(), -25.0, 25.0, clamped.data(), count); });
+        double lerpNs = timeKernel(count, [&] { math->lerp(x.data(), y.data(), t.data(), mixed.data(), count); });
+        
+        double atan2Error = 0.0, sincosError = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            atan2Error = std::max(atan2Error, std::fabs(angles[i] - std::atan2(y[i], x[i])));
+            sincosError = std::max(sincosError, std::fabs(sines[i] - std::sin(radians[i])));
+            sincosError = std::max(sincosError, std::fabs(cosines[i] - std::cos(radians[i])));
+        }
+        
+        // Every level must match the first one exactly
+        bool identical = true;
+        if (firstRanges.empty()) {
+            firstRanges = ranges;
+            firstAngles = angles;
+            firstSines = sines;
+            firstCosines = cosines;
+            firstClamped = clamped;
+            firstMixed = mixed;
+        } else {
+            identical = std::memcmp(firstRanges.data(), ranges.data(), count * sizeof(double)) == 0
+                && std::memcmp(firstAngles.data(), angles.data(), count * sizeof(double)) == 0
+                && std::memcmp(firstSines.data(), sines.data(), count * sizeof(double)) == 0
+                && std::memcmp(firstCosines.data(), cosines.data(), count * sizeof(double)) == 0
+                && std::memcmp(firstClamped.data(), clamped.data(), count * sizeof(double)) == 0
+                && std::memcmp(firstMixed.data(), mixed.data(), count * sizeof(double)) == 0;
+            allIdentical = allIdentical && identical;
+        }
+        
+        std::cout << std::left << std::setw(10) << math->name << std::fixed << std::setprecision(2)
+                  << std::setw(10) << hypotNs << std::setw(10) << atan2Ns << std::setw(10) << sincosNs
+                  << std::setw(10) << clampNs << std::setw(10) << lerpNs << std::scientific << std::setprecision(1)
+                  << std::setw(14) << atan2Error << std::setw(14) << sincosError << std::defaultfloat
+                  << (identical ? "identical" : "DIFFERENT") << std::endl;
+    }
+    
+    if (!allIdentical) {
+        std::cout << "Math kernel levels disagree" << std::endl;
+        return 1;
+    }
+    return 0;
+}
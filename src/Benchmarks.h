@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+
+// Performance reports run from the command line instead of the game.
+// Each returns the process exit code.
+
+// Times the enemy update over 1..maxThreads threads (0 = all cores) and
+// checks every parallel and double-buffered result is bit-identical to the
+// serial one.
+int runEnemyScalingReport(size_t enemyCount, int maxThreads, int ticks);
+
+// Memory held per enemy, the single-thread cost of the update pass and a
+// position scan per unit, and the cost of killing and respawning a unit.
+int runEnemyLayoutReport(size_t enemyCount, int ticks);
+
+// The batched radar detection kernel against the scalar path at 1k, 100k
+// and 1M contacts, checking both give the same detections.
+int runDetectionReport();
+
+// Each math kernel on every instruction set this CPU supports: time per
+// element, error against libm, and whether all levels agree bit for bit.
+int runMathKernelReport();
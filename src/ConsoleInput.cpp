@@ -0,0 +1,77 @@
+#include "ConsoleInput.h"
+#include <iostream>
+
+ConsoleInput& ConsoleInput::instance() {
+    // Intentionally never destroyed: the reader thread may still be blocked in getline at exit
+    static ConsoleInput* input = new ConsoleInput();
+    return *input;
+}
+
+ConsoleInput::ConsoleInput() : closed(false), linePos(0) {
+}
+
+void ConsoleInput::ensureStarted() {
+    std::call_once(startFlag, [this]() {
+        reader = std::thread(&ConsoleInput::readLoop, this);
+        reader.detach();
+    });
+}
+
+void ConsoleInput::readLoop() {
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        while (!lines.push(std::move(line))) {
+            // Queue full - the simulation is behind on input, back off briefly
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        line.clear();
+        notifyConsumer();
+    }
+    closed.store(true, std::memory_order_release);
+    notifyConsumer();
+}
+
+void ConsoleInput::notifyConsumer() {
+    { std::lock_guard<std::mutex> lock(wakeMutex); }
+    wakeSignal.notify_one();
+}
+
+bool ConsoleInput::nextToken(std::string& token) {
+    ensureStarted();
+    
+    for (;;) {
+        size_t start = currentLine.find_first_not_of(" \t\r", linePos);
+        if (start != std::string::npos) {
+            size_t end = currentLine.find_first_of(" \t\r", start);
+            if (end == std::string::npos) end = currentLine.size();
+            token.assign(currentLine, start, end - start);
+            linePos = end;
+            return true;
+        }
+        
+        if (!lines.pop(currentLine)) {
+            currentLine.clear();
+            linePos = 0;
+            return false;
+        }
+        linePos = 0;
+    }
+}
+
+bool ConsoleInput::hasInput() {
+    ensureStarted();
+    return currentLine.find_first_not_of(" \t\r", linePos) != std::string::npos || !lines.empty();
+}
+
+void ConsoleInput::waitForInput() {
+    ensureStarted();
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wakeSignal.wait(lock, [this]() { return !lines.empty() || isClosed(); });
+}
+
+bool ConsoleInput::waitForInput(std::chrono::steady_clock::time_point deadline) {
+    ensureStarted();
+    if (hasInput()) return true;
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    return wakeSignal.wait_until(lock, deadline, [this]() { return !lines.empty() || isClosed(); });
+}
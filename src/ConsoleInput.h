@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include "SpscQueue.h"
+
+// Reads stdin on a background thread and hands complete lines to the
+// simulation thread through a lock-free queue, so the simulation can keep
+// ticking while a menu waits for the pilot. stdin is process-wide, so
+// there is a single instance.
+class ConsoleInput {
+public:
+    static ConsoleInput& instance();
+    
+    // Consumer side (simulation thread)
+    bool nextToken(std::string& token);     // non-blocking, whitespace-separated like operator>>
+    bool hasInput();
+    void waitForInput();
+    bool waitForInput(std::chrono::steady_clock::time_point deadline); // false on timeout
+    bool isClosed() const { return closed.load(std::memory_order_acquire); }
+
+private:
+    ConsoleInput();
+    ConsoleInput(const ConsoleInput&) = delete;
+    ConsoleInput& operator=(const ConsoleInput&) = delete;
+    
+    void ensureStarted();
+    void readLoop();
+    void notifyConsumer();
+    
+    SpscQueue<std::string, 64> lines;
+    std::atomic<bool> closed;           // stdin reached EOF
+    std::once_flag startFlag;
+    std::thread reader;
+    
+    // Only used to sleep/wake the consumer; the queue itself is lock-free
+    std::mutex wakeMutex;
+    std::condition_variable wakeSignal;
+    
+    // Consumer-side tokenizer state
+    std::string currentLine;
+    size_t linePos;
+};
@@ -0,0 +1,49 @@
+#include "DetectionKernel.h"
+#include "SimMath.h"
+
+void DetectionBatch::clear() {
+    x.clear();
+    y.clear();
+    airborne.clear();
+}
+
+void DetectionBatch::add(double contactX, double contactY, bool isAirborne) {
+    x.push_back(contactX);
+    y.push_back(contactY);
+    airborne.push_back(isAirborne ? 1 : 0);
+}
+
+static void resizeResults(DetectionBatch& batch) {
+    batch.probabilities.resize(batch.size());
+    batch.ranges.resize(batch.size());
+    batch.bearings.resize(batch.size());
+}
+
+void detectContactsScalar(const RadarParameters& radar, DetectionBatch& batch) {
+    resizeResults(batch);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        double dx = batch.x[i] - radar.x;
+        double dy = batch.y[i] - radar.y;
+        double distance = simDistance(dx, dy);
+
+        // Same steps as Helicopter::calculateDetection
+        SimReal chance = distance > radar.range ? SimReal(0) : SimReal(1) - static_cast<SimReal>(distance / radar.range);
+        chance *= static_cast<SimReal>(radar.weatherEffect);
+        chance *= static_cast<SimReal>(radar.health);
+        if (batch.airborne[i]) chance *= SimReal(0.7);
+
+        batch.probabilities[i] = chance;
+        batch.ranges[i] = distance;
+        batch.bearings[i] = simBearing(dx, dy);
+    }
+}
+
+void detectContacts(const RadarParameters& radar, DetectionBatch& batch) {
+    resizeResults(batch);
+    mathKernels().detect(radar, batch.x.data(), batch.y.data(), batch.airborne.data(),
+                         batch.probabilities.data(), batch.ranges.data(), batch.bearings.data(), batch.size());
+}
+
+const char* detectionKernelName() {
+    return mathKernels().name;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "MathKernels.h"
+#include <vector>
+#include <cstddef>
+
+// Contacts in structure-of-arrays form, with the kernel's results alongside.
+// Keep a batch around and refilling it does not allocate.
+struct DetectionBatch {
+    std::vector<double> x, y;                   // km
+    std::vector<unsigned char> airborne;
+    std::vector<double> probabilities;          // as Helicopter::calculateDetection
+    std::vector<double> ranges;                 // km
+    std::vector<double> bearings;               // degrees, 0-360
+
+    size_t size() const { return x.size(); }
+    void clear();
+    void add(double contactX, double contactY, bool isAirborne);
+};
+
+// Detection probability, range and bearing for every contact in the batch,
+// through the widest math kernels the CPU supports. Probabilities and ranges
+// match the scalar path bit for bit; bearings come from a polynomial
+// arctangent within 1e-5 degrees of libm.
+void detectContacts(const RadarParameters& radar, DetectionBatch& batch);
+
+// The same results one contact at a time, through SimMath
+void detectContactsScalar(const RadarParameters& radar, DetectionBatch& batch);
+
+// Name of the math kernel level detectContacts runs on
+const char* detectionKernelName();
@@ -1,228 +1,84 @@
-#include "Enemy.h"
-#include <random>
+#include "EnemyStore.h"
+#include "Snapshot.h"
+#include "SimMath.h"
 #include <iostream>
 #include <cmath>
 #include <iomanip>
 
-// Define M_PI for Windows compatibility
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
-Enemy::Enemy(const std::string& type, int health, int minDamage, int maxDamage)
-    : type(type), enemyType(EnemyType::SCOUT_DRONE), health(health), maxHealth(health),
-      minDamage(minDamage), maxDamage(maxDamage), position(0, 0, 0, 0),
-      behavior(EnemyBehavior::PATROL), currentPatrolPoint(0), isAlerted(false),
-      alertLevel(0.0), lastSeenTarget(0.0), moveSpeed(20.0), isEngaging(false),
-      rng(std::random_device{}()), damageRange(minDamage, maxDamage) {
-    
-    initializeCapabilities();
-}
-
-Enemy::Enemy(const std::string& type, int health)
-    : type(type), enemyType(EnemyType::SCOUT_DRONE), health(health), maxHealth(health),
-      minDamage(10), maxDamage(20), position(0, 0, 0, 0),
-      behavior(EnemyBehavior::PATROL), currentPatrolPoint(0), isAlerted(false),
-      alertLevel(0.0), lastSeenTarget(0.0), moveSpeed(20.0), isEngaging(false),
-      rng(std::random_device{}()), damageRange(10, 20) {
-    
-    initializeCapabilities();
-}
-
-Enemy::Enemy(EnemyType type, const EnemyPosition& pos)
-    : enemyType(type), position(pos), behavior(EnemyBehavior::PATROL),
-      currentPatrolPoint(0), isAlerted(false), alertLevel(0.0), lastSeenTarget(0.0),
-      moveSpeed(20.0), isEngaging(false), rng(std::random_device{}()) {
-    
-    // Set basic attributes based on enemy type
-    switch (type) {
-        case EnemyType::SCOUT_DRONE:
-            this->type = "Scout Drone";
-            health = maxHealth = 30;
-            minDamage = 5; maxDamage = 15;
-            moveSpeed = 80.0;
-            break;
-        case EnemyType::ATTACK_DRONE:
-            this->type = "Attack Drone";
-            health = maxHealth = 50;
-            minDamage = 10; maxDamage = 25;
-            moveSpeed = 60.0;
-            break;
-        case EnemyType::LIGHT_TANK:
-            this->type = "Light Tank";
-            health = maxHealth = 80;
-            minDamage = 15; maxDamage = 25;
-            moveSpeed = 40.0;
-            break;
-        case EnemyType::HEAVY_TANK:
-            this->type = "Heavy Tank";
-            health = maxHealth = 180;
-            minDamage = 35; maxDamage = 50;
-            moveSpeed = 25.0;
-            break;
-        case EnemyType::SAM_SITE:
-            this->type = "SAM Site";
-            health = maxHealth = 60;
-            minDamage = 25; maxDamage = 45;
-            moveSpeed = 0.0; // Stationary
-            break;
-        case EnemyType::FIGHTER_JET:
-            this->type = "Fighter Jet";
-            health = maxHealth = 120;
-            minDamage = 45; maxDamage = 80;
-            moveSpeed = 500.0;
-            break;
-        case EnemyType::ATTACK_HELICOPTER:
-            this->type = "Attack Helicopter";
-            health = maxHealth = 90;
-            minDamage = 25; maxDamage = 45;
-            moveSpeed = 200.0;
-            break;
-        case EnemyType::MOBILE_AAA:
-            this->type = "Mobile AAA";
-            health = maxHealth = 70;
-            minDamage = 15; maxDamage = 30;
-            moveSpeed = 35.0;
-            break;
-    }
-    
-    damageRange = std::uniform_int_distribution<int>(minDamage, maxDamage);
-    initializeCapabilities();
-}
-
-void Enemy::initializeCapabilities() {
-    switch (enemyType) {
-        case EnemyType::SCOUT_DRONE:
-            capabilities.detectionRange = 8.0;
-            capabilities.engagementRange = 3.0;
-            capabilities.maxSpeed = 80.0;
-            capabilities.armor = 0.1;
-            capabilities.hasRadar = true;
-            capabilities.isAirborne = true;
-            capabilities.canMove = true;
-            break;
-        case EnemyType::ATTACK_DRONE:
-            capabilities.detectionRange = 6.0;
-            capabilities.engagementRange = 4.0;
-            capabilities.maxSpeed = 60.0;
-            capabilities.armor = 0.2;
-            capabilities.hasRadar = true;
-            capabilities.isAirborne = true;
-            capabilities.canMove = true;
-            break;
-        case EnemyType::LIGHT_TANK:
-            capabilities.detectionRange = 4.0;
-            capabilities.engagementRange = 4.5;
-            capabilities.maxSpeed = 40.0;
-            capabilities.armor = 0.3;
-            capabilities.hasRadar = false;
-            capabilities.isAirborne = false;
-            capabilities.canMove = true;
-            break;
-        case EnemyType::HEAVY_TANK:
-            capabilities.detectionRange = 4.0;
-            capabilities.engagementRange = 8.0;
-            capabilities.maxSpeed = 25.0;
-            capabilities.armor = 0.6;
-            capabilities.hasRadar = false;
-            capabilities.isAirborne = false;
-            capabilities.canMove = true;
-            break;
-        case EnemyType::SAM_SITE:
-            capabilities.detectionRange = 10.0;
-            capabilities.engagementRange = 8.0;
-            capabilities.maxSpeed = 0.0;
-            capabilities.armor = 0.2;
-            capabilities.hasRadar = true;
-            capabilities.isAirborne = false;
-            capabilities.canMove = false;
-            break;
-        case EnemyType::FIGHTER_JET:
-            capabilities.detectionRange = 20.0;
-            capabilities.engagementRange = 15.0;
-            capabilities.maxSpeed = 500.0;
-            capabilities.armor = 0.2;
-            capabilities.hasRadar = true;
-            capabilities.isAirborne = true;
-            capabilities.canMove = true;
-            break;
-        case EnemyType::ATTACK_HELICOPTER:
-            capabilities.detectionRange = 10.0;
-            capabilities.engagementRange = 8.0;
-            capabilities.maxSpeed = 200.0;
-            capabilities.armor = 0.3;
-            capabilities.hasRadar = true;
-            capabilities.isAirborne = true;
-            capabilities.canMove = true;
-            break;
-        case EnemyType::MOBILE_AAA:
-            capabilities.detectionRange = 8.0;
-            capabilities.engagementRange = 6.0;
-            capabilities.maxSpeed = 35.0;
-            capabilities.armor = 0.3;
-            capabilities.hasRadar = true;
-            capabilities.isAirborne = false;
-            capabilities.canMove = true;
-            break;
-    }
-}
-
-std::string Enemy::getType() const {
-    return type;
+void Enemy::setId(EntityId value) {
+    units->ids[index] = value;
+    units->touch();
 }
 
-int Enemy::getHealth() const {
-    return health;
+const char* EnemyView::getType() const {
+    return archetype().name;
 }
 
 void Enemy::takeDamage(int damage) {
     // Apply armor reduction
-    double actualDamage = damage * (1.0 - capabilities.armor);
-    health -= static_cast<int>(actualDamage);
+    const EnemyArchetype& profile = archetype();
+    double actualDamage = damage * (1.0 - profile.capabilities.armor);
+    int health = units->health[index] - static_cast<int>(actualDamage);
     
     if (health < 0) health = 0;
+    units->setHealth(index, health);
     
-    std::cout << type << " takes " << static_cast<int>(actualDamage) 
+    std::cout << profile.name << " takes " << static_cast<int>(actualDamage) 
               << " damage (armor reduced from " << damage << ")" << std::endl;
     
     // Become alerted when taking damage
-    isAlerted = true;
-    alertLevel = 1.0;
+    units->setAlerted(index, true);
+    units->alertLevels[index] = 1.0;
 }
 
-int Enemy::attackDamage() const {
-    return damageRange(rng);
+int EnemyView::attackDamage(const RandomService& random) const {
+    const EnemyArchetype& profile = archetype();
+    return random.uniformInt(profile.minDamage, profile.maxDamage,
+                             random.key(getId(), RandomPurpose::ENEMY_DAMAGE));
 }
 
 void Enemy::updatePosition(double deltaTime) {
-    if (!capabilities.canMove) return;
+    if (!getCapabilities().canMove) return;
     
     updateAI(deltaTime);
     
-    if (behavior == EnemyBehavior::PATROL && !patrolRoute.empty()) {
+    if (units->behaviors[index] == EnemyBehavior::PATROL && !units->patrolRoutes[index].empty()) {
         updatePatrol(deltaTime);
     }
 }
 
+bool EnemyView::isIdle() const {
+    // An alerted unit is never idle, even a fixed one: it has to stay awake
+    // to keep firing back
+    if (store->alerted[index]) return false;
+    if (!getCapabilities().canMove) return true;
+    bool patrolling = store->behaviors[index] == EnemyBehavior::PATROL && !store->patrolRoutes[index].empty();
+    return !patrolling;
+}
+
 void Enemy::updateAI(double deltaTime) {
     // Simple AI logic
-    if (isAlerted) {
-        alertLevel += deltaTime * 0.1; // Increase alertness over time
+    if (units->alerted[index]) {
+        double& lastSeenTarget = units->lastSeenTimes[index];
+        units->alertLevels[index] += deltaTime * 0.1; // Increase alertness over time
         lastSeenTarget += deltaTime;
         
         // Return to patrol if no contact for a while
         if (lastSeenTarget > 30.0) {
-            isAlerted = false;
-            alertLevel = 0.0;
-            behavior = EnemyBehavior::PATROL;
+            units->setAlerted(index, false);
+            units->alertLevels[index] = 0.0;
+            units->setBehavior(index, EnemyBehavior::PATROL);
         }
     }
 }
 
 void Enemy::updatePatrol(double deltaTime) {
+    const std::pmr::vector<EnemyPosition>& patrolRoute = units->patrolRoutes[index];
     if (patrolRoute.empty()) return;
     
-    EnemyPosition& target = patrolRoute[currentPatrolPoint];
+    size_t& currentPatrolPoint = units->patrolPoints[index];
+    EnemyPosition& position = units->positions[index];
+    const EnemyPosition& target = patrolRoute[currentPatrolPoint];
     double distance = calculateDistance(position, target);
     
     if (distance < 0.5) { // Reached waypoint
@@ -231,7 +87,7 @@ void Enemy::updatePatrol(double deltaTime) {
         // Move towards waypoint
         double dx = target.x - position.x;
         double dy = target.y - position.y;
-        double moveDistance = (moveSpeed / 3600.0) * deltaTime; // km
+        double moveDistance = (archetype().moveSpeed / 3600.0) * deltaTime; // km
         
         if (distance > 0) {
             position.x += (dx / distance) * moveDistance;
@@ -240,80 +96,99 @@ void Enemy::updatePatrol(double deltaTime) {
     }
 }
 
-double Enemy::calculateDistance(const EnemyPosition& pos1, const EnemyPosition& pos2) const {
+double EnemyView::getTimeToNextWaypoint() const {
+    const std::pmr::vector<EnemyPosition>& patrolRoute = store->patrolRoutes[index];
+    double moveSpeed = archetype().moveSpeed;
+    if (!getCapabilities().canMove || store->behaviors[index] != EnemyBehavior::PATROL || patrolRoute.empty()) return -1.0;
+    if (moveSpeed <= 0) return -1.0;
+    
+    double distance = calculateDistance(store->positions[index], patrolRoute[store->patrolPoints[index]]);
+    if (distance < 0.5) return 0.0; // Switches waypoint on the next update
+    return (distance - 0.5) / (moveSpeed / 3600.0);
+}
+
+double EnemyView::getTimeToAlertTimeout() const {
+    if (!getCapabilities().canMove || !store->alerted[index]) return -1.0;
+    return std::max(0.0, 30.0 - store->lastSeenTimes[index]);
+}
+
+double EnemyView::calculateDistance(const EnemyPosition& pos1, const EnemyPosition& pos2) const {
     double dx = pos1.x - pos2.x;
     double dy = pos1.y - pos2.y;
-    return sqrt(dx*dx + dy*dy);
+    return simDistance(dx, dy);
 }
 
-bool Enemy::detectTarget(const EnemyPosition& targetPos, double stealthFactor) const {
-    double distance = calculateDistance(position, targetPos);
+bool EnemyView::detectTarget(const EnemyPosition& targetPos, double stealthFactor, const RandomService& random) const {
+    const EnemyCapabilities& capabilities = getCapabilities();
+    double distance = calculateDistance(getPosition(), targetPos);
     
     if (distance > capabilities.detectionRange) return false;
     
     // Detection probability based on distance and stealth
-    double detectionChance = 1.0 - (distance / capabilities.detectionRange);
-    detectionChance *= (1.0 - stealthFactor);
+    SimReal detectionChance = SimReal(1) - static_cast<SimReal>(distance / capabilities.detectionRange);
+    detectionChance *= SimReal(1) - static_cast<SimReal>(stealthFactor);
     
     // Radar bonus
     if (capabilities.hasRadar) {
-        detectionChance *= 1.5;
+        detectionChance *= SimReal(1.5);
     }
     
-    std::uniform_real_distribution<double> detectRoll(0.0, 1.0);
-    return detectRoll(rng) < detectionChance;
+    return random.uniform(random.key(getId(), RandomPurpose::ENEMY_DETECTION)) < detectionChance;
 }
 
-bool Enemy::canEngageTarget(const EnemyPosition& targetPos) const {
-    double distance = calculateDistance(position, targetPos);
-    return distance <= capabilities.engagementRange;
+bool EnemyView::canEngageTarget(const EnemyPosition& targetPos) const {
+    double distance = calculateDistance(getPosition(), targetPos);
+    return distance <= getCapabilities().engagementRange;
 }
 
-double Enemy::calculateHitProbability(double distance, double targetSpeed, double evasionBonus) const {
-    double hitChance = 0.8; // Base hit chance
+double EnemyView::calculateHitProbability(double distance, double targetSpeed, double evasionBonus) const {
+    const EnemyCapabilities& capabilities = getCapabilities();
+    SimReal hitChance = SimReal(0.8); // Base hit chance
     
     // Range factor
-    hitChance *= (1.0 - distance / capabilities.engagementRange);
+    hitChance *= SimReal(1) - static_cast<SimReal>(distance / capabilities.engagementRange);
     
     // Target speed factor
-    hitChance *= (1.0 / (1.0 + targetSpeed / 100.0));
+    hitChance *= SimReal(1) / (SimReal(1) + static_cast<SimReal>(targetSpeed) / SimReal(100));
     
     // Apply target evasion bonus (countermeasures, evasive maneuvers)
-    hitChance *= (1.0 - evasionBonus);
+    hitChance *= SimReal(1) - static_cast<SimReal>(evasionBonus);
     
     // Radar bonus for guided systems
     if (capabilities.hasRadar) {
-        hitChance *= 1.2;
+        hitChance *= SimReal(1.2);
     }
     
-    return std::max(0.0, std::min(1.0, hitChance));
+    return std::max(SimReal(0), std::min(SimReal(1), hitChance));
 }
 
-void Enemy::performAttack(const EnemyPosition& targetPos) const {
-    double distance = calculateDistance(position, targetPos);
+void EnemyView::performAttack(const EnemyPosition& targetPos) const {
+    double distance = calculateDistance(getPosition(), targetPos);
     
     if (canEngageTarget(targetPos)) {
-        std::cout << type << " engages target at " << distance << "km range!" << std::endl;
+        std::cout << getType() << " engages target at " << distance << "km range!" << std::endl;
     }
 }
 
 void Enemy::setPatrolRoute(const std::vector<EnemyPosition>& route) {
-    patrolRoute = route;
-    currentPatrolPoint = 0;
+    units->patrolRoutes[index].assign(route.begin(), route.end());
+    units->patrolPoints[index] = 0;
+    units->touch();
 }
 
 void Enemy::setBehavior(EnemyBehavior newBehavior) {
-    behavior = newBehavior;
+    units->setBehavior(index, newBehavior);
 }
 
 void Enemy::reactToThreat(const EnemyPosition& threatPos) {
-    isAlerted = true;
-    alertLevel = 1.0;
-    lastSeenTarget = 0.0;
-    targetPosition = threatPos;
+    units->setAlerted(index, true);
+    units->alertLevels[index] = 1.0;
+    units->lastSeenTimes[index] = 0.0;
+    units->targetPositions[index] = threatPos;
     
     // Change behavior based on enemy type
-    switch (enemyType) {
+    EnemyBehavior behavior;
+    switch (units->types[index]) {
         case EnemyType::SCOUT_DRONE:
             behavior = EnemyBehavior::EVASIVE;
             break;
@@ -326,11 +201,13 @@ void Enemy::reactToThreat(const EnemyPosition& threatPos) {
             behavior = EnemyBehavior::DEFENSIVE;
             break;
     }
+    units->setBehavior(index, behavior);
 }
 
-bool Enemy::hasLineOfSight(const EnemyPosition& targetPos) const {
+bool EnemyView::hasLineOfSight(const EnemyPosition& targetPos) const {
     // Simplified line of sight calculation
-    double distance = calculateDistance(position, targetPos);
+    const EnemyCapabilities& capabilities = getCapabilities();
+    double distance = calculateDistance(getPosition(), targetPos);
     
     // Air targets generally have good line of sight
     if (capabilities.isAirborne) return true;
@@ -339,12 +216,14 @@ bool Enemy::hasLineOfSight(const EnemyPosition& targetPos) const {
     return distance < capabilities.detectionRange * 0.8;
 }
 
-void Enemy::showDetailedStatus() const {
-    std::cout << "\n=== " << type << " STATUS ===" << std::endl;
-    std::cout << "Health: " << health << "/" << maxHealth << std::endl;
+void EnemyView::showDetailedStatus() const {
+    const EnemyArchetype& profile = archetype();
+    const EnemyPosition& position = getPosition();
+    std::cout << "\n=== " << profile.name << " STATUS ===" << std::endl;
+    std::cout << "Health: " << getHealth() << "/" << profile.maxHealth << std::endl;
     std::cout << "Position: (" << position.x << ", " << position.y << ") at " << position.altitude << "m" << std::endl;
     std::cout << "Behavior: ";
-    switch (behavior) {
+    switch (getBehavior()) {
         case EnemyBehavior::PATROL: std::cout << "Patrol"; break;
         case EnemyBehavior::AGGRESSIVE: std::cout << "Aggressive"; break;
         case EnemyBehavior::DEFENSIVE: std::cout << "Defensive"; break;
@@ -352,34 +231,48 @@ void Enemy::showDetailedStatus() const {
         case EnemyBehavior::FORMATION: std::cout << "Formation"; break;
     }
     std::cout << std::endl;
-    std::cout << "Alert Level: " << std::fixed << std::setprecision(0) << alertLevel * 100 << "%" << std::endl;
-    std::cout << "Detection Range: " << capabilities.detectionRange << "km" << std::endl;
-    std::cout << "Engagement Range: " << capabilities.engagementRange << "km" << std::endl;
+    std::cout << "Alert Level: " << std::fixed << std::setprecision(0) << store->alertLevels[index] * 100 << "%" << std::endl;
+    std::cout << "Detection Range: " << profile.capabilities.detectionRange << "km" << std::endl;
+    std::cout << "Engagement Range: " << profile.capabilities.engagementRange << "km" << std::endl;
+}
+
+void EnemyView::fillSnapshot(EnemySnapshot& snapshot) const {
+    const EnemyArchetype& profile = archetype();
+    snapshot.type = profile.name;
+    snapshot.position = getPosition();
+    snapshot.health = getHealth();
+    snapshot.maxHealth = profile.maxHealth;
+    snapshot.behavior = getBehavior();
+    snapshot.isAirborne = profile.capabilities.isAirborne;
+    snapshot.detectionRange = profile.capabilities.detectionRange;
+    snapshot.engagementRange = profile.capabilities.engagementRange;
 }
 
-void Enemy::joinFormation(const std::vector<Enemy*>& formation) {
-    behavior = EnemyBehavior::FORMATION;
+void Enemy::joinFormation(const std::vector<Enemy>& formation) {
+    units->setBehavior(index, EnemyBehavior::FORMATION);
     // Formation logic would be implemented here
 }
 
-void Enemy::coordinateAttack(const std::vector<Enemy*>& allies, const EnemyPosition& target) {
+void Enemy::coordinateAttack(const std::vector<Enemy>& allies, const EnemyPosition& target) {
     // Coordinate with other units for synchronized attack
-    for (auto* ally : allies) {
-        if (ally != this && ally->canEngageTarget(target)) {
-            ally->setBehavior(EnemyBehavior::AGGRESSIVE);
+    for (Enemy ally : allies) {
+        bool self = ally.store == store && ally.index == index;
+        if (!self && ally.canEngageTarget(target)) {
+            ally.setBehavior(EnemyBehavior::AGGRESSIVE);
         }
     }
 }
 
-EnemyPosition Enemy::calculateInterceptPosition(const EnemyPosition& targetPos, double targetSpeed) const {
+EnemyPosition EnemyView::calculateInterceptPosition(const EnemyPosition& targetPos, double targetSpeed) const {
     // Simple intercept calculation
-    double distance = calculateDistance(position, targetPos);
-    double timeToIntercept = distance / capabilities.maxSpeed;
+    double distance = calculateDistance(getPosition(), targetPos);
+    double timeToIntercept = distance / getCapabilities().maxSpeed;
     
     // Predict where target will be
     EnemyPosition interceptPos = targetPos;
-    interceptPos.x += targetSpeed * timeToIntercept * cos(targetPos.heading * M_PI / 180.0);
-    interceptPos.y += targetSpeed * timeToIntercept * sin(targetPos.heading * M_PI / 180.0);
+    double heading = targetPos.heading / SIM_DEGREES_PER_RADIAN;
+    interceptPos.x += targetSpeed * timeToIntercept * simCos(heading);
+    interceptPos.y += targetSpeed * timeToIntercept * simSin(heading);
     
     return interceptPos;
 }
@@ -1,6 +1,10 @@
 #pragma once
 #include <string>
-#include <random>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "RandomService.h"
+#include "SimulationLod.h"
 
 enum class EnemyType {
     SCOUT_DRONE,
@@ -21,6 +25,13 @@ enum class EnemyBehavior {
     FORMATION
 };
 
+const size_t ENEMY_TYPE_COUNT = static_cast<size_t>(EnemyType::MOBILE_AAA) + 1;
+const size_t ENEMY_BEHAVIOR_COUNT = static_cast<size_t>(EnemyBehavior::FORMATION) + 1;
+
+// Sets of types or behaviors as bit masks, for filters and per-type tables
+constexpr uint32_t enemyTypeBit(EnemyType type) { return 1u << static_cast<uint32_t>(type); }
+constexpr uint32_t enemyBehaviorBit(EnemyBehavior behavior) { return 1u << static_cast<uint32_t>(behavior); }
+
 struct EnemyPosition {
     double x, y, altitude;
     double heading;  // degrees
@@ -28,6 +39,8 @@ struct EnemyPosition {
         : x(x), y(y), altitude(alt), heading(h) {}
 };
 
+struct EnemySnapshot;
+
 struct EnemyCapabilities {
     double detectionRange;   // km
     double engagementRange;  // km
@@ -38,79 +51,111 @@ struct EnemyCapabilities {
     bool canMove;
 };
 
-class Enemy {
+class EnemyStore;
+struct EnemyArchetype;
+
+// Stable reference to an enemy. Unlike an index it survives other units
+// being added or removed, and once its unit is destroyed lookups fail
+// instead of landing on whichever unit reused the slot.
+struct EnemyHandle {
+    uint32_t slot;
+    uint32_t generation;    // 0 is never issued, so a default handle is always stale
+    
+    EnemyHandle() : slot(0), generation(0) {}
+    EnemyHandle(uint32_t slot, uint32_t generation) : slot(slot), generation(generation) {}
+};
+
+// Read-only handle to one unit held in an EnemyStore, as handed out by a
+// const store. Handles are cheap to copy and stay valid until a unit in
+// front of them is erased.
+class EnemyView {
 public:
-    Enemy(const std::string& type, int health, int minDamage, int maxDamage);
-    Enemy(const std::string& type, int health);
-    Enemy(EnemyType type, const EnemyPosition& pos);
+    EnemyView(const EnemyStore& store, size_t index) : store(&store), index(index) {}
+    EnemyView(const EnemyView& other) = default;
+    EnemyView& operator=(const EnemyView&) = delete;   // would rebind
+    
+    size_t getIndex() const { return index; }
+    EnemyHandle getHandle() const;
+    
+    // Identity, keys this enemy's random draws
+    EntityId getId() const;
     
     // Basic properties
-    std::string getType() const;
+    const char* getType() const;       // archetype name, no copy
+    EnemyType getEnemyType() const;
     int getHealth() const;
-    int getMaxHealth() const { return maxHealth; }
-    void takeDamage(int damage);
-    bool isAlive() const { return health > 0; }
+    int getMaxHealth() const;
+    bool isAlive() const;
     
     // Combat methods
-    int attackDamage() const;
+    int attackDamage(const RandomService& random) const;
     bool canEngageTarget(const EnemyPosition& targetPos) const;
     double calculateHitProbability(double distance, double targetSpeed, double evasionBonus = 0.0) const;
     void performAttack(const EnemyPosition& targetPos) const;
     
     // AI and movement
-    void updatePosition(double deltaTime);
-    void setPatrolRoute(const std::vector<EnemyPosition>& route);
-    void setBehavior(EnemyBehavior behavior);
-    void reactToThreat(const EnemyPosition& threatPos);
+    double getMoveSpeed() const;
+    double getTimeToNextWaypoint() const;   // seconds, -1 if not patrolling
+    double getTimeToAlertTimeout() const;   // seconds, -1 if not alerted
+    bool isOnAlert() const;
+    bool isIdle() const;                    // not alerted, and updatePosition would change nothing
+    
+    // Level-of-detail scheduling, owned by the update pass
+    const LodState& getLodState() const;
     
     // Detection and awareness
-    bool detectTarget(const EnemyPosition& targetPos, double stealthFactor) const;
-    double getDetectionRange() const { return capabilities.detectionRange; }
+    bool detectTarget(const EnemyPosition& targetPos, double stealthFactor, const RandomService& random) const;
+    double getDetectionRange() const;
     bool hasLineOfSight(const EnemyPosition& targetPos) const;
     
     // Status and information
-    const EnemyPosition& getPosition() const { return position; }
-    const EnemyCapabilities& getCapabilities() const { return capabilities; }
-    EnemyBehavior getBehavior() const { return behavior; }
-    bool isAirTarget() const { return capabilities.isAirborne; }
+    const EnemyPosition& getPosition() const;
+    const EnemyCapabilities& getCapabilities() const;
+    EnemyBehavior getBehavior() const;
+    bool isAirTarget() const;
     void showDetailedStatus() const;
+    void fillSnapshot(EnemySnapshot& snapshot) const;
+
+protected:
+    friend class EnemyStore;
+    
+    const EnemyStore* store;
+    size_t index;
+    
+    // Private helper methods
+    const EnemyArchetype& archetype() const;
+    double calculateDistance(const EnemyPosition& pos1, const EnemyPosition& pos2) const;
+    EnemyPosition calculateInterceptPosition(const EnemyPosition& targetPos, double targetSpeed) const;
+};
+
+// Handle to one unit held in a writable EnemyStore: everything a view reads,
+// plus the calls that change the unit.
+class Enemy : public EnemyView {
+public:
+    Enemy(EnemyStore& store, size_t index) : EnemyView(store, index), units(&store) {}
+    Enemy(const Enemy& other) = default;
+    Enemy& operator=(const Enemy&) = delete;   // would rebind, use EnemyStore::copyState
+    
+    void setId(EntityId value);
+    void takeDamage(int damage);
+    
+    // AI and movement
+    void updatePosition(double deltaTime);
+    void setPatrolRoute(const std::vector<EnemyPosition>& route);
+    void setBehavior(EnemyBehavior behavior);
+    void reactToThreat(const EnemyPosition& threatPos);
+    
+    // Level-of-detail scheduling, owned by the update pass
+    using EnemyView::getLodState;
+    LodState& getLodState();
     
     // Formation and coordination
-    void joinFormation(const std::vector<Enemy*>& formation);
-    void coordinateAttack(const std::vector<Enemy*>& allies, const EnemyPosition& target);
+    void joinFormation(const std::vector<Enemy>& formation);
+    void coordinateAttack(const std::vector<Enemy>& allies, const EnemyPosition& target);
 
 private:
-    // Core attributes
-    std::string type;
-    EnemyType enemyType;
-    int health;
-    int maxHealth;
-    int minDamage;
-    int maxDamage;
-    EnemyPosition position;
-    EnemyCapabilities capabilities;
-    EnemyBehavior behavior;
-    
-    // AI state
-    std::vector<EnemyPosition> patrolRoute;
-    size_t currentPatrolPoint;
-    bool isAlerted;
-    double alertLevel;      // 0.0 to 1.0
-    double lastSeenTarget;  // time since last detection
-    
-    // Movement and targeting
-    EnemyPosition targetPosition;
-    double moveSpeed;
-    bool isEngaging;
-    
-    // Random generation
-    mutable std::mt19937 rng;
-    mutable std::uniform_int_distribution<int> damageRange;
+    EnemyStore* units;      // the same store as the view's, writable
     
-    // Private helper methods
-    void initializeCapabilities();
     void updateAI(double deltaTime);
     void updatePatrol(double deltaTime);
-    double calculateDistance(const EnemyPosition& pos1, const EnemyPosition& pos2) const;
-    EnemyPosition calculateInterceptPosition(const EnemyPosition& targetPos, double targetSpeed) const;
 };
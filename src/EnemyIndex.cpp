@@ -0,0 +1,130 @@
+#include "EnemyIndex.h"
+#include "Archetypes.h"
+#include <utility>
+
+static constexpr uint32_t airborneTypes() {
+    uint32_t mask = 0;
+    for (const EnemyArchetype& archetype : ENEMY_ARCHETYPES) {
+        if (archetype.capabilities.isAirborne) mask |= enemyTypeBit(archetype.type);
+    }
+    return mask;
+}
+
+static const uint32_t AIRBORNE_TYPES = airborneTypes();
+
+EnemyIndex::EnemyIndex(std::pmr::memory_resource* memory) : words(memory), count(0) {}
+
+EnemyIndex& EnemyIndex::operator=(const EnemyIndex& other) {
+    if (this == &other) return *this;
+    // Same capacity as the source, like the store's columns
+    words.reserve(other.words.capacity());
+    words = other.words;
+    count = other.count;
+    return *this;
+}
+
+void EnemyIndex::assign(size_t set, size_t index, bool value) {
+    uint64_t bit = uint64_t(1) << (index % 64);
+    if (value) {
+        word(set, index).bits.fetch_or(bit, std::memory_order_relaxed);
+    } else {
+        word(set, index).bits.fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+// Single-threaded paths: one load and one store, no locked read-modify-write
+void EnemyIndex::put(size_t set, size_t index, bool value) {
+    Word& target = word(set, index);
+    uint64_t bit = uint64_t(1) << (index % 64);
+    target.store(value ? (target.load() | bit) : (target.load() & ~bit));
+}
+
+void EnemyIndex::add(EnemyType type, EnemyBehavior behavior, bool alive, bool alerted) {
+    if (count % 64 == 0) {
+        words.resize(words.size() + SETS);
+    }
+    size_t index = count++;
+    put(TYPE_SETS + static_cast<size_t>(type), index, true);
+    put(BEHAVIOR_SETS + static_cast<size_t>(behavior), index, true);
+    put(ALIVE_SET, index, alive);
+    put(ALERTED_SET, index, alerted);
+}
+
+void EnemyIndex::erase(size_t index) {
+    size_t last = count - 1;
+    for (size_t set = 0; set < SETS; ++set) {
+        if (index != last) put(set, index, test(set, last));
+        put(set, last, false);      // a later add reuses the word
+    }
+    count--;
+    if (count % 64 == 0) {
+        words.resize(words.size() - SETS);
+    }
+}
+
+void EnemyIndex::swapUnits(size_t a, size_t b) {
+    if (a == b) return;
+    for (size_t set = 0; set < SETS; ++set) {
+        bool bitA = test(set, a);
+        bool bitB = test(set, b);
+        if (bitA != bitB) {
+            put(set, a, bitB);
+            put(set, b, bitA);
+        }
+    }
+}
+
+void EnemyIndex::clear() {
+    words.clear();
+    count = 0;
+}
+
+void EnemyIndex::reserve(size_t units) {
+    words.reserve((units + 63) / 64 * SETS);
+}
+
+void EnemyIndex::swap(EnemyIndex& other) {
+    words.swap(other.words);
+    std::swap(count, other.count);
+}
+
+void EnemyIndex::setBehavior(size_t index, EnemyBehavior from, EnemyBehavior to) {
+    if (from == to) return;
+    assign(BEHAVIOR_SETS + static_cast<size_t>(from), index, false);
+    assign(BEHAVIOR_SETS + static_cast<size_t>(to), index, true);
+}
+
+uint64_t EnemyIndex::anyOf(size_t firstSet, size_t setCount, uint32_t mask, size_t w) const {
+    const Word* sets = &words[w * SETS + firstSet];
+    uint64_t bits = 0;
+    for (size_t set = 0; set < setCount; ++set) {
+        if (mask & (1u << set)) bits |= sets[set].load();
+    }
+    return bits;
+}
+
+uint64_t EnemyIndex::match(const EnemyFilter& filter, size_t w) const {
+    // Excluded sets would match the unused tail of the last word
+    uint64_t bits = ~uint64_t(0);
+    if (w + 1 == wordCount() && count % 64 != 0) {
+        bits = (uint64_t(1) << (count % 64)) - 1;
+    }
+
+    uint32_t types = filter.types ? filter.types : ~uint32_t(0);
+    if (filter.required & ENEMY_AIRBORNE) types &= AIRBORNE_TYPES;
+    if (filter.excluded & ENEMY_AIRBORNE) types &= ~AIRBORNE_TYPES;
+    types &= (1u << ENEMY_TYPE_COUNT) - 1;
+    if (types != (1u << ENEMY_TYPE_COUNT) - 1) {
+        bits &= anyOf(TYPE_SETS, ENEMY_TYPE_COUNT, types, w);
+    }
+    if (filter.behaviors) {
+        bits &= anyOf(BEHAVIOR_SETS, ENEMY_BEHAVIOR_COUNT, filter.behaviors, w);
+    }
+
+    const Word* sets = &words[w * SETS];
+    if (filter.required & ENEMY_ALIVE) bits &= sets[ALIVE_SET].load();
+    if (filter.excluded & ENEMY_ALIVE) bits &= ~sets[ALIVE_SET].load();
+    if (filter.required & ENEMY_ALERTED) bits &= sets[ALERTED_SET].load();
+    if (filter.excluded & ENEMY_ALERTED) bits &= ~sets[ALERTED_SET].load();
+    return bits;
+}
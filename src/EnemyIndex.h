@@ -0,0 +1,100 @@
+#pragma once
+#include "Enemy.h"
+#include <atomic>
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Unit properties a filter can require or exclude
+enum EnemyFlag : unsigned {
+    ENEMY_ALIVE = 1u << 0,
+    ENEMY_ALERTED = 1u << 1,
+    ENEMY_AIRBORNE = 1u << 2        // a property of the type, resolved to a type mask
+};
+
+// Which units a query wants. The masks hold enemyTypeBit / enemyBehaviorBit
+// values, 0 for any.
+struct EnemyFilter {
+    uint32_t types;
+    uint32_t behaviors;
+    unsigned required;          // EnemyFlag bits every match has
+    unsigned excluded;          // EnemyFlag bits no match has
+    double x, y;                // km
+    double range;               // km from (x, y), < 0 for anywhere
+
+    EnemyFilter() : types(0), behaviors(0), required(ENEMY_ALIVE), excluded(0), x(0.0), y(0.0), range(-1.0) {}
+
+    EnemyFilter& within(double centerX, double centerY, double km) {
+        x = centerX;
+        y = centerY;
+        range = km;
+        return *this;
+    }
+};
+
+// Bitset secondary indexes over an EnemyStore's units: one bit per unit for
+// each type, each behavior, alive and alerted. A query ANDs whole words, so
+// it costs a few operations per 64 units however many match. The store keeps
+// the bits in step with its columns and reorders them with its units.
+class EnemyIndex {
+public:
+    explicit EnemyIndex(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+    EnemyIndex(const EnemyIndex& other) = default;
+    EnemyIndex(EnemyIndex&& other) = default;
+    EnemyIndex& operator=(const EnemyIndex& other);   // keeps this index's memory resource
+    EnemyIndex& operator=(EnemyIndex&& other) = default;
+
+    void add(EnemyType type, EnemyBehavior behavior, bool alive, bool alerted);
+    void erase(size_t index);           // the last unit moves into index
+    void swapUnits(size_t a, size_t b);
+    void clear();
+    void reserve(size_t count);
+    void swap(EnemyIndex& other);
+
+    // Safe to call for different units from several threads at once
+    void setBehavior(size_t index, EnemyBehavior from, EnemyBehavior to);
+    void setAlive(size_t index, bool alive) { assign(ALIVE_SET, index, alive); }
+    void setAlerted(size_t index, bool alerted) { assign(ALERTED_SET, index, alerted); }
+
+    // Units matching filter's masks and flags (not its range) in words of 64
+    size_t wordCount() const { return (count + 63) / 64; }
+    uint64_t match(const EnemyFilter& filter, size_t word) const;
+
+    size_t memoryUsage() const { return words.capacity() * sizeof(Word); }
+
+private:
+    // Units in one word may change from different threads, so the per-unit
+    // setters update bits atomically; adding, erasing, swapping and copying
+    // are only done single-threaded and use plain loads and stores
+    struct Word {
+        std::atomic<uint64_t> bits;
+
+        Word(uint64_t bits = 0) : bits(bits) {}
+        Word(const Word& other) : bits(other.load()) {}
+        Word& operator=(const Word& other) {
+            bits.store(other.load(), std::memory_order_relaxed);
+            return *this;
+        }
+        uint64_t load() const { return bits.load(std::memory_order_relaxed); }
+        void store(uint64_t value) { bits.store(value, std::memory_order_relaxed); }
+    };
+
+    // Bitsets, interleaved so all of one word's sets share a cache line or two
+    static const size_t TYPE_SETS = 0;
+    static const size_t BEHAVIOR_SETS = TYPE_SETS + ENEMY_TYPE_COUNT;
+    static const size_t ALIVE_SET = BEHAVIOR_SETS + ENEMY_BEHAVIOR_COUNT;
+    static const size_t ALERTED_SET = ALIVE_SET + 1;
+    static const size_t SETS = 16;
+    static_assert(ALERTED_SET < SETS, "bitsets must fit the word stride");
+
+    std::pmr::vector<Word> words;       // SETS words per 64 units
+    size_t count;
+
+    Word& word(size_t set, size_t index) { return words[(index / 64) * SETS + set]; }
+    const Word& word(size_t set, size_t index) const { return words[(index / 64) * SETS + set]; }
+    bool test(size_t set, size_t index) const { return (word(set, index).load() >> (index % 64)) & 1; }
+    void assign(size_t set, size_t index, bool value);
+    void put(size_t set, size_t index, bool value);
+    uint64_t anyOf(size_t firstSet, size_t setCount, uint32_t mask, size_t w) const;
+};
@@ -0,0 +1,316 @@
+#include "EnemyStore.h"
+#include <atomic>
+#include <utility>
+#include <bitset>
+
+// Revisions are drawn from one counter so stores never match by accident
+static std::atomic<unsigned long long> nextRevision(1);
+
+template <typename Column>
+static size_t columnBytes(const Column& column) {
+    return column.capacity() * sizeof(typename Column::value_type);
+}
+
+template <typename Column>
+static void swapRemove(Column& column, size_t index) {
+    if (index + 1 != column.size()) {
+        column[index] = std::move(column.back());
+    }
+    column.pop_back();
+}
+
+template <typename Column>
+static void copyColumn(Column& to, const Column& from) {
+    // Take the source's capacity up front so copies made after later kills
+    // and spawns fit in the buffers this one leaves behind
+    to.reserve(from.capacity());
+    to = from;
+}
+
+EnemyStore::EnemyStore(std::pmr::memory_resource* memory)
+    : types(memory), positions(memory), health(memory), behaviors(memory), alerted(memory),
+      alertLevels(memory), lastSeenTimes(memory), patrolPoints(memory), lodStates(memory),
+      targetPositions(memory), engaging(memory), patrolRoutes(memory), ids(memory),
+      slots(memory), slotIndices(memory), generations(memory), freeSlots(memory), indexes(memory),
+      revision(0) {}
+
+EnemyStore& EnemyStore::operator=(const EnemyStore& other) {
+    if (this == &other) return *this;
+    copyColumn(types, other.types);
+    copyColumn(positions, other.positions);
+    copyColumn(health, other.health);
+    copyColumn(behaviors, other.behaviors);
+    copyColumn(alerted, other.alerted);
+    copyColumn(alertLevels, other.alertLevels);
+    copyColumn(lastSeenTimes, other.lastSeenTimes);
+    copyColumn(patrolPoints, other.patrolPoints);
+    copyColumn(lodStates, other.lodStates);
+    copyColumn(targetPositions, other.targetPositions);
+    copyColumn(engaging, other.engaging);
+    copyColumn(patrolRoutes, other.patrolRoutes);
+    copyColumn(ids, other.ids);
+    copyColumn(slots, other.slots);
+    copyColumn(slotIndices, other.slotIndices);
+    copyColumn(generations, other.generations);
+    copyColumn(freeSlots, other.freeSlots);
+    indexes = other.indexes;
+    revision = other.revision;
+    return *this;
+}
+
+void EnemyStore::touch() {
+    revision = nextRevision++;
+}
+
+Enemy EnemyStore::add(EnemyType type, const EnemyPosition& pos) {
+    // Everything type-specific stays in the archetype, so spawning is a row of appends
+    types.push_back(type);
+    positions.push_back(pos);
+    health.push_back(enemyArchetype(type).maxHealth);
+    behaviors.push_back(EnemyBehavior::PATROL);
+    alerted.push_back(0);
+    alertLevels.push_back(0.0);
+    lastSeenTimes.push_back(0.0);
+    patrolPoints.push_back(0);
+    lodStates.push_back(LodState());
+    targetPositions.push_back(EnemyPosition());
+    engaging.push_back(0);
+    patrolRoutes.emplace_back();
+    ids.push_back(0);
+    indexes.add(type, EnemyBehavior::PATROL, health.back() > 0, false);
+    
+    // Reuse a dead slot when there is one
+    uint32_t slot;
+    if (freeSlots.empty()) {
+        slot = static_cast<uint32_t>(generations.size());
+        generations.push_back(1);
+        slotIndices.push_back(0);
+        // Every slot may end up free at once; erase must not allocate
+        if (freeSlots.capacity() < generations.capacity()) {
+            freeSlots.reserve(generations.capacity());
+        }
+    } else {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    slotIndices[slot] = static_cast<uint32_t>(positions.size() - 1);
+    slots.push_back(slot);
+    
+    touch();
+    return Enemy(*this, positions.size() - 1);
+}
+
+Enemy EnemyStore::add(const EnemyView& source) {
+    const EnemyStore& from = *source.store;
+    size_t i = source.index;
+    Enemy enemy = add(from.types[i], from.positions[i]);
+    copyState(enemy.index, from, i);
+    patrolRoutes[enemy.index] = from.patrolRoutes[i];
+    ids[enemy.index] = from.ids[i];
+    return enemy;
+}
+
+void EnemyStore::erase(size_t index) {
+    uint32_t slot = slots[index];
+    ++generations[slot];
+    freeSlots.push_back(slot);
+    if (index + 1 != size()) {
+        slotIndices[slots.back()] = static_cast<uint32_t>(index);
+    }
+    
+    swapRemove(types, index);
+    swapRemove(positions, index);
+    swapRemove(health, index);
+    swapRemove(behaviors, index);
+    swapRemove(alerted, index);
+    swapRemove(alertLevels, index);
+    swapRemove(lastSeenTimes, index);
+    swapRemove(patrolPoints, index);
+    swapRemove(lodStates, index);
+    swapRemove(targetPositions, index);
+    swapRemove(engaging, index);
+    swapRemove(patrolRoutes, index);
+    swapRemove(ids, index);
+    swapRemove(slots, index);
+    indexes.erase(index);
+    touch();
+}
+
+void EnemyStore::swapUnits(size_t a, size_t b) {
+    if (a == b) return;
+    std::swap(types[a], types[b]);
+    std::swap(positions[a], positions[b]);
+    std::swap(health[a], health[b]);
+    std::swap(behaviors[a], behaviors[b]);
+    std::swap(alerted[a], alerted[b]);
+    std::swap(alertLevels[a], alertLevels[b]);
+    std::swap(lastSeenTimes[a], lastSeenTimes[b]);
+    std::swap(patrolPoints[a], patrolPoints[b]);
+    std::swap(lodStates[a], lodStates[b]);
+    std::swap(targetPositions[a], targetPositions[b]);
+    std::swap(engaging[a], engaging[b]);
+    patrolRoutes[a].swap(patrolRoutes[b]);
+    std::swap(ids[a], ids[b]);
+    std::swap(slots[a], slots[b]);
+    slotIndices[slots[a]] = static_cast<uint32_t>(a);
+    slotIndices[slots[b]] = static_cast<uint32_t>(b);
+    indexes.swapUnits(a, b);
+}
+
+void EnemyStore::clear() {
+    // Kill every live handle; the slots stay for reuse
+    for (uint32_t slot : slots) {
+        ++generations[slot];
+        freeSlots.push_back(slot);
+    }
+    
+    types.clear();
+    positions.clear();
+    health.clear();
+    behaviors.clear();
+    alerted.clear();
+    alertLevels.clear();
+    lastSeenTimes.clear();
+    patrolPoints.clear();
+    lodStates.clear();
+    targetPositions.clear();
+    engaging.clear();
+    patrolRoutes.clear();
+    ids.clear();
+    slots.clear();
+    indexes.clear();
+    touch();
+}
+
+void EnemyStore::reserve(size_t count) {
+    types.reserve(count);
+    positions.reserve(count);
+    health.reserve(count);
+    behaviors.reserve(count);
+    alerted.reserve(count);
+    alertLevels.reserve(count);
+    lastSeenTimes.reserve(count);
+    patrolPoints.reserve(count);
+    lodStates.reserve(count);
+    targetPositions.reserve(count);
+    engaging.reserve(count);
+    patrolRoutes.reserve(count);
+    ids.reserve(count);
+    slots.reserve(count);
+    indexes.reserve(count);
+}
+
+void EnemyStore::swap(EnemyStore& other) {
+    types.swap(other.types);
+    positions.swap(other.positions);
+    health.swap(other.health);
+    behaviors.swap(other.behaviors);
+    alerted.swap(other.alerted);
+    alertLevels.swap(other.alertLevels);
+    lastSeenTimes.swap(other.lastSeenTimes);
+    patrolPoints.swap(other.patrolPoints);
+    lodStates.swap(other.lodStates);
+    targetPositions.swap(other.targetPositions);
+    engaging.swap(other.engaging);
+    patrolRoutes.swap(other.patrolRoutes);
+    ids.swap(other.ids);
+    slots.swap(other.slots);
+    slotIndices.swap(other.slotIndices);
+    generations.swap(other.generations);
+    freeSlots.swap(other.freeSlots);
+    indexes.swap(other.indexes);
+    std::swap(revision, other.revision);
+}
+
+// The column writes that change what the indexes hold go through these
+
+void EnemyStore::setHealth(size_t index, int value) {
+    if ((health[index] > 0) != (value > 0)) {
+        indexes.setAlive(index, value > 0);
+    }
+    health[index] = value;
+}
+
+void EnemyStore::setBehavior(size_t index, EnemyBehavior behavior) {
+    indexes.setBehavior(index, behaviors[index], behavior);
+    behaviors[index] = behavior;
+}
+
+void EnemyStore::setAlerted(size_t index, bool value) {
+    if ((alerted[index] != 0) == value) return;
+    alerted[index] = value ? 1 : 0;
+    indexes.setAlerted(index, value);
+}
+
+template <typename Visit>
+void EnemyStore::forEachMatch(const EnemyFilter& filter, Visit visit) const {
+    double rangeSquared = filter.range * filter.range;
+    for (size_t w = 0; w < indexes.wordCount(); ++w) {
+        uint64_t bits = indexes.match(filter, w);
+        while (bits) {
+            // Lowest set bit first keeps the matches in index order
+            uint64_t lowest = bits & (~bits + 1);
+            size_t index = w * 64 + std::bitset<64>(lowest - 1).count();
+            bits ^= lowest;
+            if (filter.range >= 0.0) {
+                double dx = positions[index].x - filter.x;
+                double dy = positions[index].y - filter.y;
+                if (dx * dx + dy * dy > rangeSquared) continue;
+            }
+            visit(index);
+        }
+    }
+}
+
+void EnemyStore::select(const EnemyFilter& filter, std::vector<size_t>& matches) const {
+    matches.clear();
+    forEachMatch(filter, [&matches](size_t index) { matches.push_back(index); });
+}
+
+size_t EnemyStore::count(const EnemyFilter& filter) const {
+    size_t total = 0;
+    if (filter.range < 0.0) {
+        // No positions to check, the words can be counted whole
+        for (size_t w = 0; w < indexes.wordCount(); ++w) {
+            total += std::bitset<64>(indexes.match(filter, w)).count();
+        }
+    } else {
+        forEachMatch(filter, [&total](size_t) { total++; });
+    }
+    return total;
+}
+
+void EnemyStore::copyState(size_t index, const EnemyStore& source) {
+    copyState(index, source, index);
+}
+
+void EnemyStore::copyState(size_t index, const EnemyStore& source, size_t sourceIndex) {
+    positions[index] = source.positions[sourceIndex];
+    setHealth(index, source.health[sourceIndex]);
+    setBehavior(index, source.behaviors[sourceIndex]);
+    setAlerted(index, source.alerted[sourceIndex] != 0);
+    alertLevels[index] = source.alertLevels[sourceIndex];
+    lastSeenTimes[index] = source.lastSeenTimes[sourceIndex];
+    patrolPoints[index] = source.patrolPoints[sourceIndex];
+    lodStates[index] = source.lodStates[sourceIndex];
+    targetPositions[index] = source.targetPositions[sourceIndex];
+    engaging[index] = source.engaging[sourceIndex];
+}
+
+size_t EnemyStore::memoryUsage() const {
+    size_t bytes = columnBytes(types) + columnBytes(positions) + columnBytes(health)
+                 + columnBytes(behaviors) + columnBytes(alerted) + columnBytes(alertLevels)
+                 + columnBytes(lastSeenTimes) + columnBytes(patrolPoints) + columnBytes(lodStates)
+                 + columnBytes(targetPositions) + columnBytes(engaging) + columnBytes(patrolRoutes)
+                 + columnBytes(ids) + columnBytes(slots) + columnBytes(slotIndices)
+                 + columnBytes(generations) + columnBytes(freeSlots) + indexes.memoryUsage();
+    for (const auto& route : patrolRoutes) {
+        bytes += columnBytes(route);
+    }
+    return bytes;
+}
+
+size_t EnemyStore::hotBytesPerUnit() {
+    return sizeof(EnemyType) + sizeof(EnemyPosition) + sizeof(int) + sizeof(EnemyBehavior)
+         + sizeof(unsigned char) + 2 * sizeof(double) + sizeof(size_t) + sizeof(LodState);
+}
@@ -0,0 +1,160 @@
+#pragma once
+#include "Enemy.h"
+#include "Archetypes.h"
+#include "EnemyIndex.h"
+#include <vector>
+#include <memory_resource>
+#include <cstddef>
+
+// Every enemy in structure-of-arrays form. The fields the update and scan
+// passes touch each tick live in their own contiguous columns; data shared
+// by a type comes from its archetype. Enemy handles index into the columns.
+class EnemyStore {
+public:
+    class Iterator {
+    public:
+        Iterator(EnemyStore* store, size_t index) : store(store), index(index) {}
+        Enemy operator*() const { return Enemy(*store, index); }
+        Iterator& operator++() { ++index; return *this; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+    private:
+        EnemyStore* store;
+        size_t index;
+    };
+    
+    // Yields read-only views
+    class ConstIterator {
+    public:
+        ConstIterator(const EnemyStore* store, size_t index) : store(store), index(index) {}
+        EnemyView operator*() const { return EnemyView(*store, index); }
+        ConstIterator& operator++() { ++index; return *this; }
+        bool operator!=(const ConstIterator& other) const { return index != other.index; }
+    private:
+        const EnemyStore* store;
+        size_t index;
+    };
+    
+    // Columns and patrol routes draw from memory; stores that swap must share it
+    explicit EnemyStore(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+    EnemyStore(const EnemyStore& other) = default;
+    EnemyStore(EnemyStore&& other) = default;
+    EnemyStore& operator=(const EnemyStore& other);   // keeps this store's memory resource
+    EnemyStore& operator=(EnemyStore&& other) = default;
+    
+    // Spawning, each returns a handle to the new unit
+    Enemy add(EnemyType type, const EnemyPosition& pos);
+    Enemy add(const EnemyView& source);              // copy of a unit from any store
+    void erase(size_t index);                        // O(1), the last unit moves into index
+    void swapUnits(size_t a, size_t b);              // reorders only, handles follow their units
+    void clear();
+    void reserve(size_t count);
+    void swap(EnemyStore& other);
+    
+    size_t size() const { return positions.size(); }
+    bool empty() const { return positions.empty(); }
+    Enemy operator[](size_t index) { return Enemy(*this, index); }
+    EnemyView operator[](size_t index) const { return EnemyView(*this, index); }
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, size()); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, size()); }
+    
+    // Generational handles
+    EnemyHandle getHandle(size_t index) const;
+    int indexOf(EnemyHandle handle) const;          // -1 once the unit is gone
+    bool contains(EnemyHandle handle) const { return indexOf(handle) >= 0; }
+    
+    // Filtered queries answered from the secondary indexes. select fills
+    // matches with unit indices in ascending order; keep the vector around
+    // and repeated queries do not allocate.
+    void select(const EnemyFilter& filter, std::vector<size_t>& matches) const;
+    size_t count(const EnemyFilter& filter) const;
+    
+    // Copies the state a tick can change for one unit. source must hold the
+    // same units (same revision), so types and patrol routes are left alone.
+    void copyState(size_t index, const EnemyStore& source);
+    
+    // Changes whenever units are added or removed or their patrol routes change;
+    // two stores with the same revision hold the same units, provided swapUnits
+    // calls on one are repeated on the other.
+    unsigned long long getRevision() const { return revision; }
+    
+    // Bytes held for the units, including heap storage behind them
+    size_t memoryUsage() const;
+    static size_t hotBytesPerUnit();
+
+private:
+    friend class EnemyView;
+    friend class Enemy;
+    
+    // Hot columns, read or written by every update and scan
+    std::pmr::vector<EnemyType> types;       // indexes ENEMY_ARCHETYPES
+    std::pmr::vector<EnemyPosition> positions;
+    std::pmr::vector<int> health;
+    std::pmr::vector<EnemyBehavior> behaviors;
+    std::pmr::vector<unsigned char> alerted;
+    std::pmr::vector<double> alertLevels;    // 0.0 to 1.0
+    std::pmr::vector<double> lastSeenTimes;  // seconds since last detection
+    std::pmr::vector<size_t> patrolPoints;
+    std::pmr::vector<LodState> lodStates;
+    
+    // Warm columns, only touched when a unit reacts to a threat
+    std::pmr::vector<EnemyPosition> targetPositions;
+    std::pmr::vector<unsigned char> engaging;
+    
+    // Read by patrolling units, written only by setPatrolRoute
+    std::pmr::vector<std::pmr::vector<EnemyPosition>> patrolRoutes;
+    
+    // Cold data
+    std::pmr::vector<EntityId> ids;
+    std::pmr::vector<uint32_t> slots;        // handle slot of each unit
+    
+    // Slot map, indexed by handle slot
+    std::pmr::vector<uint32_t> slotIndices;  // unit index of each live slot
+    std::pmr::vector<uint32_t> generations;  // bumped when the slot's unit dies
+    std::pmr::vector<uint32_t> freeSlots;
+    
+    // Secondary indexes over types, behaviors, health and alerted
+    EnemyIndex indexes;
+    
+    unsigned long long revision;
+    
+    void setHealth(size_t index, int value);
+    void setBehavior(size_t index, EnemyBehavior behavior);
+    void setAlerted(size_t index, bool value);
+    template <typename Visit>
+    void forEachMatch(const EnemyFilter& filter, Visit visit) const;
+    void copyState(size_t index, const EnemyStore& source, size_t sourceIndex);
+    void touch();
+};
+
+// Handle lookups sit on the spatial query paths
+inline EnemyHandle EnemyStore::getHandle(size_t index) const {
+    uint32_t slot = slots[index];
+    return EnemyHandle(slot, generations[slot]);
+}
+
+inline int EnemyStore::indexOf(EnemyHandle handle) const {
+    if (handle.slot >= generations.size() || generations[handle.slot] != handle.generation) {
+        return -1;
+    }
+    return static_cast<int>(slotIndices[handle.slot]);
+}
+
+// Hot accessors, inline so the update loops see straight column and table reads
+inline const EnemyArchetype& EnemyView::archetype() const { return enemyArchetype(store->types[index]); }
+inline EnemyType EnemyView::getEnemyType() const { return store->types[index]; }
+inline EntityId EnemyView::getId() const { return store->ids[index]; }
+inline EnemyHandle EnemyView::getHandle() const { return store->getHandle(index); }
+inline int EnemyView::getHealth() const { return store->health[index]; }
+inline int EnemyView::getMaxHealth() const { return archetype().maxHealth; }
+inline bool EnemyView::isAlive() const { return store->health[index] > 0; }
+inline double EnemyView::getMoveSpeed() const { return archetype().capabilities.canMove ? archetype().moveSpeed : 0.0; }
+inline bool EnemyView::isOnAlert() const { return store->alerted[index] != 0; }
+inline LodState& Enemy::getLodState() { return units->lodStates[index]; }
+inline const LodState& EnemyView::getLodState() const { return store->lodStates[index]; }
+inline double EnemyView::getDetectionRange() const { return archetype().capabilities.detectionRange; }
+inline const EnemyPosition& EnemyView::getPosition() const { return store->positions[index]; }
+inline const EnemyCapabilities& EnemyView::getCapabilities() const { return archetype().capabilities; }
+inline EnemyBehavior EnemyView::getBehavior() const { return store->behaviors[index]; }
+inline bool EnemyView::isAirTarget() const { return archetype().capabilities.isAirborne; }
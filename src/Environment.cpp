@@ -1,4 +1,5 @@
 #include "Environment.h"
+#include "Snapshot.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -6,50 +7,62 @@
 Environment::Environment() 
     : currentWeather(WeatherCondition::CLEAR), weatherDuration(60.0), 
       weatherChangeTimer(0.0), dynamicWeather(true), windSpeed(10.0), 
-      windDirection(90.0), currentTerrain(TerrainType::DESERT), 
-      timeOfDay(12.0), dayDuration(120.0), electronicWarfare(false), 
-      radarJamming(0.0), dustStorm(false), rng(std::random_device{}()) {
+      windDirection(90.0), windGustTimer(0.0), windGustInterval(1.0), windGusts(0), weatherChanges(0),
+      currentTerrain(TerrainType::DESERT), timeOfDay(12.0), dayDuration(120.0), electronicWarfare(false), 
+      radarJamming(0.0), dustStorm(false) {
 }
 
-void Environment::updateWeather(double deltaTime) {
+void Environment::updateWeather(double deltaTime, const RandomService& random) {
     if (!dynamicWeather) return;
     
-    weatherChangeTimer += deltaTime;
+    // Wind drifts in fixed gusts keyed by gust number, so one long step draws
+    // the same sequence as many short ones
+    windGustTimer += deltaTime;
+    while (windGustTimer >= windGustInterval - 1e-9) {
+        windGustTimer -= windGustInterval;
+        
+        RandomKey speedKey(WORLD_ENTITY, windGusts, RandomPurpose::WIND_SPEED);
+        RandomKey directionKey(WORLD_ENTITY, windGusts, RandomPurpose::WIND_DIRECTION);
+        windGusts++;
+        
+        windSpeed += random.uniformReal(-5.0, 5.0, speedKey) * windGustInterval;
+        windSpeed = std::max(0.0, std::min(50.0, windSpeed));
+        
+        windDirection += random.uniformReal(-5.0, 5.0, directionKey) * windGustInterval * 10.0;
+        if (windDirection >= 360.0) windDirection -= 360.0;
+        if (windDirection < 0.0) windDirection += 360.0;
+    }
+    
+    weatherChangeTimer += deltaTime / 60.0; // deltaTime is in seconds, weather timers in minutes
     
     if (weatherChangeTimer >= weatherDuration) {
-        randomizeWeather();
+        randomizeWeather(random);
         weatherChangeTimer = 0.0;
     }
-    
-    // Update wind
-    std::uniform_real_distribution<double> windDist(-5.0, 5.0);
-    windSpeed += windDist(rng) * deltaTime;
-    windSpeed = std::max(0.0, std::min(50.0, windSpeed));
-    
-    windDirection += windDist(rng) * deltaTime * 10.0;
-    if (windDirection >= 360.0) windDirection -= 360.0;
-    if (windDirection < 0.0) windDirection += 360.0;
 }
 
-void Environment::randomizeWeather() {
-    std::uniform_int_distribution<int> weatherDist(0, 4);
-    int weatherChoice = weatherDist(rng);
-    
-    WeatherCondition newWeather = static_cast<WeatherCondition>(weatherChoice);
+double Environment::getTimeToWeatherChange() const {
+    if (!dynamicWeather) return -1.0;
+    return std::max(0.0, (weatherDuration - weatherChangeTimer) * 60.0);
+}
+
+void Environment::randomizeWeather(const RandomService& random) {
+    uint64_t roll = weatherChanges++;
+    WeatherCondition newWeather = getRandomWeather(random, roll);
     
     if (newWeather != currentWeather) {
         currentWeather = newWeather;
         std::cout << "Weather change: " << getWeatherDescription() << std::endl;
         
         // Set new weather duration
-        std::uniform_real_distribution<double> durationDist(30.0, 120.0);
-        weatherDuration = durationDist(rng);
+        weatherDuration = random.uniformReal(30.0, 120.0,
+                                             RandomKey(WORLD_ENTITY, roll, RandomPurpose::WEATHER_DURATION));
     }
 }
 
-WeatherCondition Environment::getRandomWeather() const {
-    std::uniform_int_distribution<int> dist(0, 4);
-    return static_cast<WeatherCondition>(dist(rng));
+WeatherCondition Environment::getRandomWeather(const RandomService& random, uint64_t counter) const {
+    int choice = random.uniformInt(0, 4, RandomKey(WORLD_ENTITY, counter, RandomPurpose::WEATHER_CHOICE));
+    return static_cast<WeatherCondition>(choice);
 }
 
 double Environment::getVisibilityModifier() const {
@@ -236,8 +249,8 @@ double Environment::calculateCommunicationReliability() const {
     return reliability;
 }
 
-std::vector<std::string> Environment::getEnvironmentalWarnings() const {
-    std::vector<std::string> warnings;
+void Environment::getEnvironmentalWarnings(std::vector<const char*>& warnings) const {
+    warnings.clear();
     
     if (getVisibilityModifier() < 0.5) {
         warnings.push_back("Low visibility conditions");
@@ -258,8 +271,6 @@ std::vector<std::string> Environment::getEnvironmentalWarnings() const {
     if (isNightTime()) {
         warnings.push_back("Night operations - reduced visibility");
     }
-    
-    return warnings;
 }
 
 void Environment::showEnvironmentalStatus() const {
@@ -281,10 +292,11 @@ void Environment::showEnvironmentalStatus() const {
     std::cout << "Wind: " << std::fixed << std::setprecision(0) 
               << windSpeed << " km/h from " << windDirection << " deg" << std::endl;
     
-    auto warnings = getEnvironmentalWarnings();
+    std::vector<const char*> warnings;
+    getEnvironmentalWarnings(warnings);
     if (!warnings.empty()) {
         std::cout << "\nWarnings:" << std::endl;
-        for (const auto& warning : warnings) {
+        for (const char* warning : warnings) {
             std::cout << "[!] " << warning << std::endl;
         }
     }
@@ -305,3 +317,12 @@ void Environment::showDetailedEnvironment() const {
     
     std::cout << "\n" << getTerrainDescription() << std::endl;
 }
+
+void Environment::fillSnapshot(EnvironmentSnapshot& snapshot) const {
+    snapshot.weather = currentWeather;
+    snapshot.terrain = currentTerrain;
+    snapshot.timeOfDay = timeOfDay;
+    snapshot.windSpeed = windSpeed;
+    snapshot.windDirection = windDirection;
+    snapshot.visibility = getVisibilityModifier();
+}
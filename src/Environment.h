@@ -1,14 +1,17 @@
 #pragma once
-#include <random>
 #include <vector>
 #include "Mission.h"
+#include "RandomService.h"
+
+struct EnvironmentSnapshot;
 
 class Environment {
 public:
     Environment();
     
     // Weather system
-    void updateWeather(double deltaTime);
+    void updateWeather(double deltaTime, const RandomService& random);
+    double getTimeToWeatherChange() const;   // seconds, -1 if weather is static
     WeatherCondition getCurrentWeather() const { return currentWeather; }
     double getVisibilityModifier() const;
     double getWeaponAccuracyModifier() const;
@@ -44,11 +47,13 @@ public:
     // Environmental effects on gameplay
     double calculateDetectionModifier() const;
     double calculateCommunicationReliability() const;
-    std::vector<std::string> getEnvironmentalWarnings() const;
+    // Fills warnings (cleared first) with static strings, so a reused vector never allocates
+    void getEnvironmentalWarnings(std::vector<const char*>& warnings) const;
     
     // Status display
     void showEnvironmentalStatus() const;
     void showDetailedEnvironment() const;
+    void fillSnapshot(EnvironmentSnapshot& snapshot) const;
 
 private:
     // Weather system
@@ -58,6 +63,10 @@ private:
     bool dynamicWeather;
     double windSpeed;             // km/h
     double windDirection;         // degrees
+    double windGustTimer;         // seconds since last wind change
+    double windGustInterval;      // seconds between wind changes
+    uint64_t windGusts;           // gusts so far, keys the wind draws
+    uint64_t weatherChanges;      // weather rolls so far, keys the weather draws
     
     // Terrain
     TerrainType currentTerrain;
@@ -71,12 +80,9 @@ private:
     double radarJamming;          // 0.0 to 1.0
     bool dustStorm;
     
-    // Random generation
-    mutable std::mt19937 rng;
-    
     // Private helper methods
-    void randomizeWeather();
-    WeatherCondition getRandomWeather() const;
+    void randomizeWeather(const RandomService& random);
+    WeatherCondition getRandomWeather(const RandomService& random, uint64_t counter) const;
     double calculateWeatherVisibility() const;
     double calculateTerrainVisibility() const;
 };
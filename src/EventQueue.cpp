@@ -0,0 +1,33 @@
+#include "EventQueue.h"
+#include <algorithm>
+
+static bool laterEvent(const SimEvent& a, const SimEvent& b) {
+    return a.time > b.time;
+}
+
+void EventQueue::push(const SimEvent& event) {
+    events.push_back(event);
+    std::push_heap(events.begin(), events.end(), laterEvent);
+}
+
+SimEvent EventQueue::pop() {
+    std::pop_heap(events.begin(), events.end(), laterEvent);
+    SimEvent event = events.back();
+    events.pop_back();
+    return event;
+}
+
+const char* simEventName(SimEventType type) {
+    switch (type) {
+        case SimEventType::DESTINATION_REACHED: return "Destination reached";
+        case SimEventType::FUEL_LOW: return "Low fuel";
+        case SimEventType::FUEL_EXHAUSTED: return "Fuel exhausted";
+        case SimEventType::WEATHER_CHANGE: return "Weather change";
+        case SimEventType::ENEMY_IN_DETECTION_RANGE: return "Entered enemy detection range";
+        case SimEventType::ENEMY_WAYPOINT: return "Enemy patrol waypoint";
+        case SimEventType::ENEMY_ALERT_TIMEOUT: return "Enemy stood down";
+        case SimEventType::MISSION_TIME_LIMIT: return "Mission time limit";
+        case SimEventType::DURATION_LIMIT: return "Time limit for fast-forward";
+        default: return "Unknown event";
+    }
+}
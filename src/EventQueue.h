@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+enum class SimEventType {
+    DESTINATION_REACHED,
+    FUEL_LOW,
+    FUEL_EXHAUSTED,
+    WEATHER_CHANGE,
+    ENEMY_IN_DETECTION_RANGE,
+    ENEMY_WAYPOINT,
+    ENEMY_ALERT_TIMEOUT,
+    MISSION_TIME_LIMIT,
+    DURATION_LIMIT
+};
+
+struct SimEvent {
+    double time;            // seconds from now
+    SimEventType type;
+    int subject;            // enemy index for enemy events, -1 otherwise
+    
+    SimEvent(double t = 0.0, SimEventType type = SimEventType::DURATION_LIMIT, int subject = -1)
+        : time(t), type(type), subject(subject) {}
+};
+
+// Min-heap of upcoming simulation events, earliest first
+class EventQueue {
+public:
+    void push(const SimEvent& event);
+    SimEvent pop();
+    const SimEvent& top() const { return events.front(); }
+    bool empty() const { return events.empty(); }
+    size_t size() const { return events.size(); }
+    void clear() { events.clear(); }
+    void reserve(size_t count) { events.reserve(count); }
+
+private:
+    std::vector<SimEvent> events;
+};
+
+const char* simEventName(SimEventType type);
@@ -1,4 +1,6 @@
 #include "Game.h"
+#include "ConsoleInput.h"
+#include "SimMath.h"
 #include <iostream>
 #include <random>
 #include <limits>
@@ -7,19 +9,153 @@
 #include <iomanip>
 #include <thread>
 #include <memory>
-#include <sstream>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+// Smaller populations fit in cache whatever their order
+static const size_t SPATIAL_ORDER_MIN_UNITS = 2048;
 
 // Constructor implementation
 Game::Game() : helicopter("AH-64 Apache"), gameState(GameState::MAIN_MENU), 
                gameRunning(true), realTimeMode(true), simSpeed(SimulationSpeed::REAL_TIME),
                deltaTime(0.0), gameTime(0.0), missionTime(0.0), timeAcceleration(1.0),
-               pausedState(false), showDebugMode(false), showAdvancedInfo(false) {
+               pausedState(false), autopilotEnabled(false), engagementTimer(0.0),
+               enemiesDestroyed(0), tickCount(0), readingInput(false), publishSnapshots(true),
+               phaseDeltaTime(0.0), doubleBuffered(false), dormancyEnabled(true), spatialOrdering(true),
+               random(std::random_device{}()), nextEntityId(FIRST_ENEMY_ENTITY),
+               lastTickMs(0.0), weatherInterval(1), pendingWeatherTime(0.0), environmentUpdated(false),
+               baseStepSize(0.0), showDebugMode(false), showAdvancedInfo(false) {
     
     initializeHelicopter();
     setupDefaultWeapons();
+    buildTickGraph();
     lastUpdateTime = std::chrono::steady_clock::now();
 }
 
+void Game::buildTickGraph() {
+    // Declaration order is the serial order; the graph only overlaps phases
+    // whose read/write sets do not conflict. With double buffering, reads go
+    // to last tick's world, which nobody writes, so only writes are declared.
+    unsigned combatReads = doubleBuffered ? 0u
+        : static_cast<unsigned>(RESOURCE_HELICOPTER | RESOURCE_ENEMIES | RESOURCE_ENVIRONMENT);
+    
+    // LOD tiers and dormancy are decided by distance to the helicopter
+    unsigned enemyReads = doubleBuffered ? 0u : static_cast<unsigned>(RESOURCE_HELICOPTER);
+    
+    tickGraph.clear();
+    tickGraph.addTask("helicopter", 0, RESOURCE_HELICOPTER,
+                      [this]() { updateHelicopter(phaseDeltaTime); });
+    tickGraph.addTask("enemies", enemyReads, RESOURCE_ENEMIES,
+                      [this]() { updateEnemies(phaseDeltaTime); });
+    tickGraph.addTask("environment", 0, RESOURCE_ENVIRONMENT,
+                      [this]() { updateEnvironment(phaseDeltaTime); });
+    tickGraph.addTask("mission", 0, RESOURCE_MISSION | RESOURCE_GAME_STATE,
+                      [this]() { if (currentMission) updateMission(phaseDeltaTime); });
+    tickGraph.addTask("combat", combatReads,
+                      RESOURCE_HELICOPTER | RESOURCE_ENEMIES | RESOURCE_MISSION | RESOURCE_GAME_STATE,
+                      [this]() { updateCombat(phaseDeltaTime); });
+}
+
+void Game::setDoubleBuffering(bool enabled) {
+    if (enabled == doubleBuffered) return;
+    doubleBuffered = enabled;
+    buildTickGraph();
+}
+
+void Game::setLodEnabled(bool enabled) {
+    if (enabled == lodSettings.enabled) return;
+    if (!enabled) {
+        // Catch every lagging enemy up before they go back to per-tick updates
+        for (Enemy enemy : enemies) {
+            LodState& state = enemy.getLodState();
+            if (state.pendingTime > 0.0) {
+                enemy.updatePosition(state.pendingTime);
+            }
+            state = LodState();
+        }
+        nextEnemies.clear();
+    }
+    lodSettings.enabled = enabled;
+    buildTickGraph();
+}
+
+void Game::setDormancyEnabled(bool enabled) {
+    dormancyEnabled = enabled;
+    activeEnemies.reset(enemies.size());
+}
+
+void Game::wakeEnemy(int enemyIndex) {
+    syncActiveEnemies();
+    if (enemyIndex >= 0 && enemyIndex < static_cast<int>(enemies.size())) {
+        activeEnemies.wake(static_cast<size_t>(enemyIndex));
+    }
+}
+
+void Game::syncActiveEnemies() {
+    // Enemies were added or removed behind our back
+    if (activeEnemies.size() != enemies.size()) {
+        activeEnemies.reset(enemies.size());
+    }
+}
+
+void Game::swapWorldBuffers() {
+    // Moves and vector swaps only - the old front becomes next tick's back buffer
+    std::swap(helicopter, nextHelicopter);
+    enemies.swap(nextEnemies);
+    for (size_t index : newlyDormant) {
+        nextEnemies.copyState(index, enemies);
+    }
+    newlyDormant.clear();
+    if (environmentUpdated) {
+        std::swap(environment, nextEnvironment);
+    }
+}
+
+void Game::reorderEnemies() {
+    // Between ticks nothing holds an index, so units can move; the back
+    // buffer and the active set follow the same swaps
+    syncActiveEnemies();
+    bool sameUnits = doubleBuffered && nextEnemies.getRevision() == enemies.getRevision();
+    for (const auto& swap : spatialOrder.step(enemies)) {
+        enemies.swapUnits(swap.first, swap.second);
+        if (sameUnits) {
+            nextEnemies.swapUnits(swap.first, swap.second);
+        }
+        activeEnemies.swapMembers(swap.first, swap.second);
+    }
+}
+
+const RelativeGeometry& Game::getEnemyGeometry() const {
+    enemyGeometry.update(helicopter.getPosition(), enemies, gameTime);
+    return enemyGeometry;
+}
+
+const SpatialGrid& Game::getEnemyGrid() const {
+    enemyGrid.update(enemies);
+    return enemyGrid;
+}
+
+const ZoneIndex& Game::getEngagementEnvelopes() const {
+    engagementEnvelopes.update(enemies);
+    return engagementEnvelopes;
+}
+
+int Game::defaultWorkerThreads() {
+    int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(0, std::min(hardware - 1, 4));
+}
+
+void Game::setWorkerThreads(int count) {
+    count = std::max(0, count);
+    if (count == getWorkerThreads()) return;
+    workerPool.reset(count > 0 ? new ThreadPool(count) : nullptr);
+}
+
+int Game::getWorkerThreads() const {
+    return workerPool ? workerPool->getWorkerCount() : 0;
+}
+
 void Game::initializeHelicopter() {
     // Initialize helicopter with realistic systems
     // Already done in Helicopter constructor
@@ -33,43 +169,56 @@ void Game::setupDefaultWeapons() {
 
 void Game::generateEnemies(MissionType type, int difficulty) {
     enemies.clear();
+    nextEntityId = FIRST_ENEMY_ENTITY;
     
     // Create realistic enemy formations based on mission type
     switch (type) {
         case MissionType::SEARCH_AND_DESTROY:
-            enemies = createEnemyFormation(EnemyType::LIGHT_TANK, 2, EnemyPosition(5.0, 3.0, 0.0));
-            enemies.push_back(Enemy(EnemyType::SAM_SITE, EnemyPosition(8.0, -2.0, 0.0)));
-            enemies.push_back(Enemy(EnemyType::SCOUT_DRONE, EnemyPosition(3.0, 5.0, 50.0)));
+            createEnemyFormation(EnemyType::LIGHT_TANK, 2, EnemyPosition(5.0, 3.0, 0.0));
+            enemies.add(EnemyType::SAM_SITE, EnemyPosition(8.0, -2.0, 0.0));
+            enemies.add(EnemyType::SCOUT_DRONE, EnemyPosition(3.0, 5.0, 50.0));
             break;
         default:
             // Default enemy setup
-            enemies.push_back(Enemy("Scout Drone", 30, 5, 15));
-            enemies.push_back(Enemy("Attack Drone", 50, 10, 20));
-            enemies.push_back(Enemy("Light Tank", 75, 15, 25));
+            enemies.add(EnemyType::SCOUT_DRONE, EnemyPosition());
+            enemies.add(EnemyType::ATTACK_DRONE, EnemyPosition());
+            enemies.add(EnemyType::LIGHT_TANK, EnemyPosition());
             break;
     }
+    for (Enemy enemy : enemies) {
+        enemy.setId(nextEntityId++);
+    }
+    activeEnemies.reset(enemies.size());
 }
 
-std::vector<Enemy> Game::createEnemyFormation(EnemyType type, int count, const EnemyPosition& centerPos) {
-    std::vector<Enemy> formation;
+void Game::createEnemyFormation(EnemyType type, int count, const EnemyPosition& centerPos) {
     for (int i = 0; i < count; ++i) {
         EnemyPosition pos = centerPos;
         pos.x += (i % 2) * 1.0 - 0.5; // Spread formation
         pos.y += (i / 2) * 1.0;
-        formation.emplace_back(type, pos);
+        enemies.add(type, pos);
     }
-    return formation;
 }
 
 void Game::start() {
     gameRunning = true;
+    lastUpdateTime = std::chrono::steady_clock::now();
+    
+    const auto frameInterval = std::chrono::milliseconds(50);
+    auto nextFrame = std::chrono::steady_clock::now();
     
     while (gameRunning) {
         update();
         render();
         
-        // Simple frame rate limiting
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        // Frame pacing only; simulation time comes from the fixed-step clock
+        nextFrame += frameInterval;
+        auto now = std::chrono::steady_clock::now();
+        if (nextFrame < now) {
+            nextFrame = now;
+        }
+        // Wake on the frame timer or as soon as the pilot types a command
+        ConsoleInput::instance().waitForInput(nextFrame);
     }
 }
 
@@ -80,55 +229,588 @@ void Game::update() {
     lastUpdateTime = currentTime;
     
     if (!pausedState) {
-        updateGameLogic(deltaTime * timeAcceleration);
+        // Bank scaled wall time and pay it out in fixed steps
+        simClock.beginFrame(deltaTime * timeAcceleration);
+        while (simClock.nextStep()) {
+            updateGameLogic(simClock.getStepSize());
+            governTick();
+        }
     }
     
     processInput();
 }
 
+double Game::getSpeedMultiplier(SimulationSpeed speed) const {
+    switch (speed) {
+        case SimulationSpeed::REAL_TIME: return 1.0;
+        case SimulationSpeed::FAST: return 10.0;
+        case SimulationSpeed::VERY_FAST: return 100.0;
+        case SimulationSpeed::PAUSED: return 0.0;
+        default: return 1.0;
+    }
+}
+
+void Game::setSimulationSpeed(SimulationSpeed speed) {
+    simSpeed = speed;
+    if (speed == SimulationSpeed::PAUSED) {
+        pauseSimulation();
+        return;
+    }
+    timeAcceleration = getSpeedMultiplier(speed);
+    resumeSimulation();
+}
+
+void Game::pauseSimulation() {
+    pausedState = true;
+}
+
+void Game::resumeSimulation() {
+    if (pausedState) {
+        // Do not bank the time spent paused
+        lastUpdateTime = std::chrono::steady_clock::now();
+    }
+    pausedState = false;
+}
+
 void Game::updateGameLogic(double dt) {
+    auto tickStart = std::chrono::steady_clock::now();
+    AllocationStats allocationsBefore = processAllocations();
     gameTime += dt;
     
-    updateHelicopter(dt);
-    updateEnemies(dt);
-    updateEnvironment(dt);
+    phaseDeltaTime = dt;
+    random.setTick(static_cast<uint64_t>(tickCount));
+    tickGraph.run(workerPool.get());
+    if (doubleBuffered) {
+        swapWorldBuffers();
+    }
+    if (spatialOrdering && enemies.size() >= SPATIAL_ORDER_MIN_UNITS) {
+        reorderEnemies();
+    }
+    enemyGeometry.invalidate();
+    enemyGrid.invalidate();
+    engagementEnvelopes.invalidate();
     
     if (currentMission) {
-        updateMission(dt);
         missionTime += dt;
     }
     
-    updateCombat(dt);
+    tickCount++;
+    if (publishSnapshots) {
+        publishSnapshot();
+    }
+    
+    std::chrono::duration<double, std::milli> tickTime = std::chrono::steady_clock::now() - tickStart;
+    lastTickMs = tickTime.count();
+    lastTickAllocations = processAllocations() - allocationsBefore;
+}
+
+void Game::governTick() {
+    if (!governor.isEnabled()) return;
+    
+    int slowest = 0;
+    for (int i = 1; i < static_cast<int>(tickGraph.getTaskCount()); ++i) {
+        if (tickGraph.getTaskTime(i) > tickGraph.getTaskTime(slowest)) slowest = i;
+    }
+    if (!governor.recordTick(tickCount, lastTickMs, tickGraph.getTaskName(slowest),
+                             tickGraph.getTaskTime(slowest))) {
+        return;
+    }
+    
+    const GovernorDecision& decision = governor.getLastDecision();
+    applyFidelity(decision.from, decision.to);
+    
+    std::cout << "\n[GOVERNOR] Tick " << decision.tick << ": "
+              << (decision.to > decision.from ? "degrading to " : "restoring ")
+              << fidelityLevelName(decision.to) << " (average tick " << std::fixed << std::setprecision(2)
+              << decision.averageMs << " ms, budget " << governor.getBudget() << " ms, slowest phase '"
+              << decision.slowestPhase << "' " << decision.slowestPhaseMs << " ms)" << std::endl;
+}
+
+void Game::applyFidelity(FidelityLevel from, FidelityLevel to) {
+    if (from == FidelityLevel::FULL) {
+        baseLodSettings = lodSettings;
+        baseStepSize = simClock.getStepSize();
+    }
+    
+    // Weather and wind only matter at human timescales - batch them first
+    weatherInterval = to >= FidelityLevel::DEFERRED_WEATHER ? 8 : 1;
+    
+    // Then let distant enemies think less often (detection promotion still holds)
+    lodSettings.nearRange = baseLodSettings.nearRange;
+    lodSettings.nearInterval = baseLodSettings.nearInterval;
+    lodSettings.farInterval = baseLodSettings.farInterval;
+    if (to >= FidelityLevel::REDUCED_AI) {
+        lodSettings.nearRange *= 0.5;
+        lodSettings.nearInterval *= 2;
+        lodSettings.farInterval *= 2;
+    }
+    
+    // Last resort: fewer, larger substeps
+    simClock.setStepSize(to >= FidelityLevel::COARSE_STEPS ? baseStepSize * 2.0 : baseStepSize);
+}
+
+void Game::publishSnapshot() {
+    WorldSnapshot* snapshot = snapshots.beginPublish();
+    if (!snapshot) return; // Every spare slot is pinned by readers - skip rather than wait
+    
+    snapshot->tick = tickCount;
+    snapshot->gameTime = gameTime;
+    helicopter.fillSnapshot(snapshot->helicopter);
+    
+    snapshot->enemies.resize(enemies.size());
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        enemies[i].fillSnapshot(snapshot->enemies[i]);
+    }
+    
+    if (currentMission) {
+        currentMission->fillSnapshot(snapshot->mission);
+    } else {
+        snapshot->mission.active = false;
+        snapshot->mission.objectives.clear();
+    }
+    
+    environment.fillSnapshot(snapshot->environment);
+    snapshots.endPublish();
 }
 
 void Game::updateHelicopter(double dt) {
-    helicopter.updatePosition(dt);
+    TaskGraph::checkAccess(RESOURCE_HELICOPTER, true);
+    Helicopter& next = doubleBuffered ? nextHelicopter : helicopter;
+    if (doubleBuffered) {
+        next = helicopter;
+    }
+    next.updatePosition(dt);
     
     // Update weapon systems
-    for (int i = 0; i < helicopter.getWeaponCount(); ++i) {
+    for (int i = 0; i < next.getWeaponCount(); ++i) {
         // Weapon updates would be handled in weapon system
     }
 }
 
 void Game::updateEnemies(double dt) {
-    for (auto& enemy : enemies) {
-        enemy.updatePosition(dt);
+    TaskGraph::checkAccess(RESOURCE_ENEMIES, true);
+    
+    LodFrame frame;
+    const LodFrame* lod = nullptr;
+    if (lodSettings.enabled) {
+        if (!doubleBuffered) {
+            TaskGraph::checkAccess(RESOURCE_HELICOPTER, false);
+        }
+        const Position& player = helicopter.getPosition();
+        frame.settings = &lodSettings;
+        frame.playerX = player.x;
+        frame.playerY = player.y;
+        frame.tick = tickCount;
+        lod = &frame;
+    }
+    
+    const std::vector<size_t>* awake = nullptr;
+    if (dormancyEnabled) {
+        syncActiveEnemies();
+        wakeDueEnemies();
+        awake = &activeEnemies.getActive();
+    }
+    
+    if (doubleBuffered) {
+        advanceEnemyPopulation(enemies, nextEnemies, dt, workerPool.get(), lod, awake);
+    } else {
+        updateEnemyPopulation(enemies, dt, workerPool.get(), lod, awake);
+    }
+    
+    if (dormancyEnabled) {
+        sleepIdleEnemies(doubleBuffered ? nextEnemies : enemies);
     }
 }
 
+void Game::wakeDueEnemies() {
+    // Dormant enemies sleep until the player could first reach their
+    // detection range; check whether that actually happened
+    dueWakes.clear();
+    dueWakes.reserve(enemies.size());   // at most one due wake per enemy
+    activeEnemies.collectDue(gameTime, dueWakes);
+    double closingSpeed = lodSettings.playerMaxSpeed / 3600.0; // km/s
+    
+    for (const SimEvent& event : dueWakes) {
+        size_t index = static_cast<size_t>(event.subject);
+        const Enemy enemy = enemies[index];
+        double distance = helicopter.calculateDistance(enemy.getPosition());
+        double margin = distance - enemy.getDetectionRange();
+        if (margin <= 0.0 || closingSpeed <= 0.0) {
+            activeEnemies.wake(index);
+        } else {
+            activeEnemies.sleep(index, gameTime + margin / closingSpeed, event.type);
+        }
+    }
+}
+
+void Game::sleepIdleEnemies(EnemyStore& updated) {
+    // Walk backwards so swap-removal only moves members already visited
+    const std::vector<size_t>& awake = activeEnemies.getActive();
+    newlyDormant.reserve(enemies.size());   // at most every awake enemy
+    double closingSpeed = lodSettings.playerMaxSpeed / 3600.0; // km/s
+    
+    for (size_t k = awake.size(); k-- > 0;) {
+        size_t index = awake[k];
+        Enemy enemy = updated[index];
+        if (!enemy.isIdle()) continue;
+        
+        double margin = helicopter.calculateDistance(enemy.getPosition()) - enemy.getDetectionRange();
+        if (margin <= 0.0) continue;
+        
+        if (doubleBuffered) {
+            // Dormant enemies are not copied forward, so both buffers must
+            // agree; the front is still being read, so swapWorldBuffers copies
+            newlyDormant.push_back(index);
+        }
+        enemy.getLodState() = LodState();
+        double wakeTime = closingSpeed > 0.0 ? gameTime + margin / closingSpeed : -1.0;
+        activeEnemies.sleep(index, wakeTime, SimEventType::ENEMY_IN_DETECTION_RANGE);
+    }
+}
+
+// Enemies only touch their own state while updating, so any split of the
+// population gives results identical to the serial loop.
+struct EnemyUpdateRange {
+    const EnemyStore* source;           // previous tick when double-buffered, else nullptr
+    EnemyStore* enemies;
+    double dt;
+    const LodFrame* lod;                // nullptr updates everyone every tick
+    const std::vector<size_t>* indices; // awake enemies, nullptr for all
+};
+
+static void updateEnemyRange(void* context, size_t begin, size_t end) {
+    EnemyUpdateRange* range = static_cast<EnemyUpdateRange*>(context);
+    const LodFrame* lod = range->lod;
+    for (size_t k = begin; k < end; ++k) {
+        size_t i = range->indices ? (*range->indices)[k] : k;
+        Enemy enemy = (*range->enemies)[i];
+        if (range->source) {
+            range->enemies->copyState(i, *range->source);
+        }
+        if (!lod) {
+            enemy.updatePosition(range->dt);
+            continue;
+        }
+        
+        LodState& state = enemy.getLodState();
+        if (!advanceLod(state, lod->tick, range->dt)) continue;
+        enemy.updatePosition(state.pendingTime);
+        
+        const EnemyPosition& pos = enemy.getPosition();
+        double dx = pos.x - lod->playerX;
+        double dy = pos.y - lod->playerY;
+        double safeTime = 0.0;
+        int interval = selectLodInterval(*lod->settings, simDistance(dx, dy),
+                                         enemy.getDetectionRange(), enemy.getMoveSpeed(),
+                                         enemy.isOnAlert(), safeTime);
+        scheduleLod(state, lod->tick, interval, safeTime, i);
+    }
+}
+
+static void runEnemyUpdate(EnemyUpdateRange& range, ThreadPool* pool) {
+    const size_t grain = 512; // enemies per chunk, small battles stay on one thread
+    size_t count = range.indices ? range.indices->size() : range.enemies->size();
+    if (!pool || count <= grain) {
+        updateEnemyRange(&range, 0, count);
+        return;
+    }
+    pool->parallelFor(count, grain, &updateEnemyRange, &range);
+}
+
+void Game::updateEnemyPopulation(EnemyStore& enemies, double dt, ThreadPool* pool,
+                                 const LodFrame* lod, const std::vector<size_t>* indices) {
+    EnemyUpdateRange range = { nullptr, &enemies, dt, lod, indices };
+    runEnemyUpdate(range, pool);
+}
+
+void Game::advanceEnemyPopulation(const EnemyStore& current, EnemyStore& next, double dt,
+                                  ThreadPool* pool, const LodFrame* lod,
+                                  const std::vector<size_t>* indices) {
+    if (next.getRevision() != current.getRevision()) {
+        // Units changed since the last swap (spawns, kills, new routes, new mission)
+        next = current;
+    }
+    EnemyUpdateRange range = { &current, &next, dt, lod, indices };
+    runEnemyUpdate(range, pool);
+}
+
 void Game::updateEnvironment(double dt) {
-    environment.updateWeather(dt);
-    environment.updateTimeOfDay(dt);
+    TaskGraph::checkAccess(RESOURCE_ENVIRONMENT, true);
+    
+    // The governor may batch weather over several ticks
+    pendingWeatherTime += dt;
+    environmentUpdated = false;
+    if (weatherInterval > 1 && tickCount % weatherInterval != 0) return;
+    
+    Environment& next = doubleBuffered ? nextEnvironment : environment;
+    if (doubleBuffered) {
+        next = environment;
+    }
+    next.updateWeather(pendingWeatherTime, random);
+    next.updateTimeOfDay(pendingWeatherTime);
+    pendingWeatherTime = 0.0;
+    environmentUpdated = true;
 }
 
 void Game::updateMission(double dt) {
+    TaskGraph::checkAccess(RESOURCE_MISSION, true);
+    TaskGraph::checkAccess(RESOURCE_GAME_STATE, true);
     currentMission->update(dt);
+    
+    // Leave flight mode once the mission resolves on its own (e.g. time limit)
+    if (gameState == GameState::IN_FLIGHT) {
+        if (currentMission->getStatus() == MissionStatus::COMPLETED) {
+            gameState = GameState::MISSION_COMPLETE;
+        } else if (currentMission->getStatus() == MissionStatus::FAILED) {
+            gameState = GameState::MISSION_FAILED;
+        }
+    }
 }
 
 void Game::updateCombat(double dt) {
     // Combat logic updates
 }
 
+void Game::updateAutopilot(double dt) {
+    if (!currentMission || currentMission->getStatus() != MissionStatus::IN_PROGRESS) return;
+    
+    if (!helicopter.isAlive()) {
+        currentMission->fail("Aircraft destroyed");
+        gameState = GameState::MISSION_FAILED;
+        return;
+    }
+    
+    FlightParams params = helicopter.getFlightParams();
+    const Position& pos = helicopter.getPosition();
+    
+    // Area clear - return to base at the origin
+    if (enemies.empty()) {
+        double baseDistance = simDistance(pos.x, pos.y);
+        if (baseDistance < 0.5) {
+            completeMission();
+            return;
+        }
+        helicopter.setDestination(Position(0, 0, pos.altitude));
+        params.speed = scenario.cruiseSpeed;
+        helicopter.setFlightParams(params);
+        return;
+    }
+    
+    // Engage the closest contact
+    const RelativeGeometry& geometry = getEnemyGeometry();
+    int targetIndex = static_cast<int>(geometry.nearest());
+    double targetDistance = geometry.getRange(targetIndex);
+    
+    // Prefer a weapon suited to the target, fall back to anything in range
+    const std::vector<Weapon>& weapons = helicopter.getWeapons();
+    EnemyType targetType = enemies[targetIndex].getEnemyType();
+    int weaponIndex = -1;
+    bool anyAmmo = false;
+    for (size_t i = 0; i < weapons.size(); ++i) {
+        if (!weapons[i].hasAmmo()) continue;
+        anyAmmo = true;
+        if (weapons[i].getRange() < targetDistance) continue;
+        if (weapons[i].isEffectiveAgainst(targetType)) {
+            weaponIndex = static_cast<int>(i);
+            break;
+        }
+        if (weaponIndex < 0) weaponIndex = static_cast<int>(i);
+    }
+    
+    if (!anyAmmo) {
+        abortMission();
+        return;
+    }
+    
+    if (weaponIndex < 0) {
+        // Close the distance
+        const EnemyPosition& target = enemies[targetIndex].getPosition();
+        helicopter.setDestination(Position(target.x, target.y, pos.altitude));
+        params.speed = scenario.cruiseSpeed;
+        helicopter.setFlightParams(params);
+        engagementTimer = scenario.engagementInterval;
+        return;
+    }
+    
+    helicopter.hover();
+    engagementTimer += dt;
+    if (engagementTimer >= scenario.engagementInterval) {
+        engagementTimer = 0.0;
+        performAttack(targetIndex, weaponIndex);
+    }
+}
+
+void Game::startHeadlessMission(const ScenarioConfig& config, unsigned int seed) {
+    scenario = config;
+    autopilotEnabled = true;
+    simClock.setStepSize(scenario.timeStep);
+    simClock.reset();
+    engagementTimer = scenario.engagementInterval;
+    enemiesDestroyed = 0;
+    tickCount = 0;
+    gameTime = 0.0;
+    
+    random.setSeed(seed);
+    random.setTick(0);
+    environment.setWeather(scenario.weather);
+    environment.setTerrain(scenario.terrain);
+    environment.enableDynamicWeather(scenario.dynamicWeather);
+    
+    generateEnemies(scenario.missionType, scenario.difficulty);
+    createMission(scenario.missionType);
+    
+    MissionParameters params = currentMission->getParameters();
+    params.timeLimit = scenario.timeLimit;
+    currentMission->setParameters(params);
+    
+    gameState = GameState::IN_FLIGHT;
+}
+
+void Game::stepSimulation() {
+    double dt = simClock.getStepSize();
+    updateGameLogic(dt);
+    if (autopilotEnabled) {
+        updateAutopilot(dt);
+    }
+}
+
+bool Game::isSimulationFinished() const {
+    if (!currentMission || currentMission->getStatus() != MissionStatus::IN_PROGRESS) return true;
+    return gameTime >= scenario.maxSimTime;
+}
+
+MissionResult Game::getMissionResult() const {
+    MissionResult result;
+    result.missionType = currentMission ? currentMission->getType() : scenario.missionType;
+    result.status = currentMission ? currentMission->getStatus() : MissionStatus::NOT_STARTED;
+    result.score = currentMission ? currentMission->calculateScore() : 0;
+    result.rating = currentMission ? currentMission->getMissionRating() : "";
+    result.simTime = gameTime;
+    result.ticks = tickCount;
+    result.enemiesDestroyed = enemiesDestroyed;
+    result.enemiesRemaining = static_cast<int>(enemies.size());
+    result.helicopterHealth = helicopter.getHealth();
+    result.fuelRemaining = helicopter.getFlightParams().fuel;
+    return result;
+}
+
+// Jumps from event to event instead of ticking through quiet stretches. Each
+// jump is rounded up to whole simulation steps, so events fire on the same
+// tick boundary that fixed-step ticking would hit.
+SimEvent Game::fastForward(double maxDuration) {
+    const double step = simClock.getStepSize();
+    double elapsed = 0.0;
+    
+    // Keyed by handle: spatial ordering may move units between jumps
+    std::vector<EnemyHandle> outOfRange;
+    const RelativeGeometry& start = getEnemyGeometry();
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        if (start.getRange(i) > enemies[i].getDetectionRange()) {
+            outOfRange.push_back(enemies.getHandle(i));
+        }
+    }
+    
+    while (elapsed < maxDuration) {
+        eventQueue.clear();
+        scheduleEvents(eventQueue, maxDuration - elapsed);
+        const SimEvent& next = eventQueue.top();
+        
+        double jump = std::max(step, std::ceil(next.time / step - 1e-9) * step);
+        
+        double fuelBefore = helicopter.getFlightParams().fuel;
+        bool travelling = helicopter.getTimeToDestination() >= 0;
+        
+        updateGameLogic(jump);
+        elapsed += jump;
+        
+        // Stop on whatever changed state the pilot needs to see
+        if (!helicopter.isAlive() || !helicopter.getSystems().engine) {
+            return SimEvent(elapsed, SimEventType::FUEL_EXHAUSTED);
+        }
+        if (fuelBefore > 50.0 && helicopter.getFlightParams().fuel <= 50.0) {
+            return SimEvent(elapsed, SimEventType::FUEL_LOW);
+        }
+        if (currentMission && currentMission->getStatus() != MissionStatus::IN_PROGRESS &&
+            currentMission->getStatus() != MissionStatus::NOT_STARTED) {
+            return SimEvent(elapsed, SimEventType::MISSION_TIME_LIMIT);
+        }
+        const RelativeGeometry& geometry = getEnemyGeometry();
+        int entered = -1;
+        for (EnemyHandle handle : outOfRange) {
+            int index = enemies.indexOf(handle);
+            if (index < 0 || (entered >= 0 && index > entered)) continue;
+            size_t i = static_cast<size_t>(index);
+            if (geometry.getRange(i) <= enemies[i].getDetectionRange()) {
+                entered = index;
+            }
+        }
+        if (entered >= 0) {
+            return SimEvent(elapsed, SimEventType::ENEMY_IN_DETECTION_RANGE, entered);
+        }
+        if (travelling && helicopter.getTimeToDestination() < 0) {
+            return SimEvent(elapsed, SimEventType::DESTINATION_REACHED);
+        }
+    }
+    
+    return SimEvent(elapsed, SimEventType::DURATION_LIMIT);
+}
+
+void Game::scheduleEvents(EventQueue& queue, double horizon) const {
+    queue.push(SimEvent(horizon, SimEventType::DURATION_LIMIT));
+    
+    double toDestination = helicopter.getTimeToDestination();
+    if (toDestination >= 0) {
+        queue.push(SimEvent(toDestination, SimEventType::DESTINATION_REACHED));
+    }
+    
+    if (helicopter.canFly()) {
+        double flow = helicopter.getFuelFlowRate();
+        double fuel = helicopter.getFlightParams().fuel;
+        if (flow > 0) {
+            if (fuel > 50.0) {
+                queue.push(SimEvent((fuel - 50.0) / flow, SimEventType::FUEL_LOW));
+            }
+            queue.push(SimEvent(fuel / flow, SimEventType::FUEL_EXHAUSTED));
+        }
+    }
+    
+    double toWeatherChange = environment.getTimeToWeatherChange();
+    if (toWeatherChange >= 0) {
+        queue.push(SimEvent(toWeatherChange, SimEventType::WEATHER_CHANGE));
+    }
+    
+    if (currentMission && currentMission->getStatus() == MissionStatus::IN_PROGRESS) {
+        double remaining = currentMission->getTimeRemaining();
+        if (remaining >= 0) {
+            queue.push(SimEvent(remaining * 60.0, SimEventType::MISSION_TIME_LIMIT));
+        }
+    }
+    
+    double helicopterSpeed = (toDestination >= 0) ? helicopter.getFlightParams().speed : 0.0;
+    const RelativeGeometry& geometry = getEnemyGeometry();
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        const EnemyView enemy = enemies[i];
+        int subject = static_cast<int>(i);
+        
+        double toWaypoint = enemy.getTimeToNextWaypoint();
+        if (toWaypoint >= 0) {
+            queue.push(SimEvent(toWaypoint, SimEventType::ENEMY_WAYPOINT, subject));
+        }
+        
+        double toStandDown = enemy.getTimeToAlertTimeout();
+        if (toStandDown >= 0) {
+            queue.push(SimEvent(toStandDown, SimEventType::ENEMY_ALERT_TIMEOUT, subject));
+        }
+        
+        // Earliest possible entry into detection range if both close head-on
+        double gap = geometry.getRange(i) - enemy.getDetectionRange();
+        double closingSpeed = (helicopterSpeed + enemy.getMoveSpeed()) / 3600.0; // km/s
+        if (gap > 0 && closingSpeed > 0) {
+            queue.push(SimEvent(gap / closingSpeed, SimEventType::ENEMY_IN_DETECTION_RANGE, subject));
+        }
+    }
+}
+
 void Game::render() {
     // Simple text-based rendering
     if (gameState == GameState::IN_FLIGHT) {
@@ -137,7 +819,59 @@ void Game::render() {
 }
 
 void Game::processInput() {
-    // Handle continuous input processing
+    // Commands typed while the main loop runs; menus read their own input
+    if (readingInput || gameState != GameState::IN_FLIGHT) return;
+    
+    std::string token;
+    if (ConsoleInput::instance().nextToken(token)) {
+        handleInFlightInput(std::atoi(token.c_str()));
+    }
+}
+
+bool Game::readToken(std::string& token) {
+    ConsoleInput& input = ConsoleInput::instance();
+    const auto frameInterval = std::chrono::milliseconds(50);
+    readingInput = true;
+    
+    bool received = false;
+    for (;;) {
+        if (input.nextToken(token)) {
+            received = true;
+            break;
+        }
+        if (input.isClosed()) {
+            received = input.nextToken(token);
+            break;
+        }
+        
+        if (realTimeMode && gameState == GameState::IN_FLIGHT) {
+            // The world keeps moving while the pilot reads the menu
+            update();
+            input.waitForInput(std::chrono::steady_clock::now() + frameInterval);
+        } else {
+            input.waitForInput();
+            lastUpdateTime = std::chrono::steady_clock::now();
+        }
+    }
+    
+    readingInput = false;
+    return received;
+}
+
+int Game::readChoice() {
+    std::string token;
+    if (!readToken(token)) return 0; // End of input behaves like "back"/"exit"
+    
+    char* end = nullptr;
+    long value = std::strtol(token.c_str(), &end, 10);
+    if (end == token.c_str() || *end != '\0') return -1;
+    return static_cast<int>(value);
+}
+
+double Game::readNumber() {
+    std::string token;
+    if (!readToken(token)) return 0.0;
+    return std::strtod(token.c_str(), nullptr);
 }
 
 void Game::showMainMenu() {
@@ -162,7 +896,7 @@ void Game::showMissionMenu() {
     std::cout << "Enter your choice: ";
     
     int choice;
-    std::cin >> choice;
+    choice = readChoice();
     
     if (choice > 0 && choice <= 5) {
         startMission(static_cast<MissionType>(choice - 1));
@@ -170,6 +904,13 @@ void Game::showMissionMenu() {
 }
 
 void Game::startMission(MissionType type) {
+    createMission(type);
+    
+    gameState = GameState::MISSION_BRIEFING;
+    enterFlightMode();
+}
+
+void Game::createMission(MissionType type) {
     // Create mission based on type
     std::string missionName;
     std::string briefing;
@@ -209,7 +950,10 @@ void Game::startMission(MissionType type) {
             break;
     }
     
-    currentMission = std::make_unique<Mission>(type, missionName, briefing);
+    // Tear the old mission down and free everything it allocated in one go
+    currentMission.reset();
+    missionArena.release();
+    currentMission = missionArena.create<Mission>(type, missionName, briefing, &missionArena);
     
     // Set mission parameters
     MissionParameters params;
@@ -221,19 +965,32 @@ void Game::startMission(MissionType type) {
     
     currentMission->setParameters(params);
     currentMission->start();
-    
-    gameState = GameState::MISSION_BRIEFING;
-    enterFlightMode();
+    missionTime = 0.0;
+}
+
+void Game::completeMission() {
+    if (currentMission) {
+        currentMission->complete();
+    }
+    gameState = GameState::MISSION_COMPLETE;
+}
+
+void Game::abortMission() {
+    if (currentMission) {
+        currentMission->abort();
+    }
+    gameState = GameState::MAIN_MENU;
 }
 
 void Game::enterFlightMode() {
     gameState = GameState::IN_FLIGHT;
+    lastUpdateTime = std::chrono::steady_clock::now();
     std::cout << "\n>> Entering flight mode..." << std::endl;
     
     int choice;
     do {
         showInFlightMenu();
-        std::cin >> choice;
+        choice = readChoice();
         handleInFlightInput(choice);
     } while (choice != 0 && gameState == GameState::IN_FLIGHT);
 }
@@ -254,6 +1011,9 @@ void Game::showInFlightMenu() {
 }
 
 void Game::handleInFlightInput(int choice) {
+    // Displays below read the published snapshot, so bring it up to date first
+    publishSnapshot();
+    
     switch (choice) {
         case 1: engageEnemy(); break;
         case 2: performRadarScan(); break;
@@ -277,26 +1037,43 @@ void Game::engageEnemy() {
     
     int targetIndex = selectEnemyTarget();
     if (targetIndex >= 0) {
+        // The world keeps ticking while the weapon menu waits for input
+        EnemyHandle target = enemies.getHandle(static_cast<size_t>(targetIndex));
         int weaponIndex = selectWeaponIndex();
-        if (weaponIndex >= 0) {
+        targetIndex = enemies.indexOf(target);
+        if (targetIndex < 0) {
+            std::cout << "Target lost." << std::endl;
+        } else if (weaponIndex >= 0) {
             performAttack(targetIndex, weaponIndex);
         }
     }
 }
 
 int Game::selectEnemyTarget() {
+    // Only live units are worth a shot; hold handles since the world keeps
+    // ticking while the menu waits
+    std::vector<size_t> targets;
+    enemies.select(EnemyFilter(), targets);
+    std::vector<EnemyHandle> handles;
+    
     std::cout << "\n=== TARGET SELECTION ===" << std::endl;
-    for (size_t i = 0; i < enemies.size(); ++i) {
-        std::cout << (i+1) << ". " << enemies[i].getType() 
-                  << " (Health: " << enemies[i].getHealth() << ")" << std::endl;
+    for (size_t k = 0; k < targets.size(); ++k) {
+        const Enemy enemy = enemies[targets[k]];
+        std::cout << (k+1) << ". " << enemy.getType() 
+                  << " (Health: " << enemy.getHealth() << ")" << std::endl;
+        handles.push_back(enemy.getHandle());
     }
     std::cout << "0. Cancel" << std::endl;
     
     int choice;
-    std::cin >> choice;
+    choice = readChoice();
     
-    if (choice > 0 && choice <= static_cast<int>(enemies.size())) {
-        return choice - 1;
+    if (choice > 0 && choice <= static_cast<int>(handles.size())) {
+        int index = enemies.indexOf(handles[choice - 1]);
+        if (index < 0) {
+            std::cout << "Target lost." << std::endl;
+        }
+        return index;
     }
     return -1;
 }
@@ -307,7 +1084,7 @@ int Game::selectWeaponIndex() {
     std::cout << "0. Cancel" << std::endl;
     
     int choice;
-    std::cin >> choice;
+    choice = readChoice();
     
     if (choice > 0 && choice <= helicopter.getWeaponCount()) {
         return choice - 1;
@@ -320,12 +1097,15 @@ void Game::performAttack(int enemyIndex, int weaponIndex) {
         weaponIndex >= 0 && weaponIndex < helicopter.getWeaponCount()) {
         
         // Calculate actual distance to target
-        double distance = helicopter.calculateDistance(enemies[enemyIndex].getPosition());
+        double distance = getEnemyGeometry().getRange(enemyIndex);
         
-        if (helicopter.attackWithWeapon(enemies[enemyIndex], weaponIndex, distance)) {
+        random.beginAction();
+        if (helicopter.attackWithWeapon(enemies[enemyIndex], weaponIndex, distance, random)) {
             if (enemies[enemyIndex].getHealth() <= 0) {
                 std::cout << enemies[enemyIndex].getType() << " destroyed!" << std::endl;
-                enemies.erase(enemies.begin() + enemyIndex);
+                enemies.erase(static_cast<size_t>(enemyIndex));
+                activeEnemies.erase(static_cast<size_t>(enemyIndex));
+                enemiesDestroyed++;
                 
                 if (currentMission) {
                     // Check if this completes mission objectives
@@ -334,7 +1114,8 @@ void Game::performAttack(int enemyIndex, int weaponIndex) {
                     }
                 }
             } else {
-                // Enemy counterattack
+                // Enemy counterattack - the target certainly knows we are here now
+                wakeEnemy(enemyIndex);
                 processEnemyTurn();
             }
         }
@@ -342,10 +1123,16 @@ void Game::performAttack(int enemyIndex, int weaponIndex) {
 }
 
 void Game::processEnemyTurn() {
-    for (auto& enemy : enemies) {
+    // Dormant enemies have not noticed us yet. Walk the store in index order
+    // rather than the awake list, whose order follows the sleep/wake history,
+    // so who fires before a lethal hit does not depend on it.
+    syncActiveEnemies();
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        if (dormancyEnabled && !activeEnemies.isAwake(i)) continue;
+        const Enemy enemy = enemies[i];
         if (enemy.getHealth() > 0) {
             // Simple enemy AI - attack if in range
-            int damage = enemy.attackDamage();
+            int damage = enemy.attackDamage(random);
             std::cout << enemy.getType() << " counterattacks for " << damage << " damage!" << std::endl;
             helicopter.takeDamage(damage);
             
@@ -362,7 +1149,12 @@ void Game::processEnemyTurn() {
 }
 
 void Game::performRadarScan() {
-    helicopter.performRadarSweep(enemies, environment.getCurrentWeather());
+    SnapshotPublisher::Handle snapshot = snapshots.acquire();
+    if (snapshot) {
+        Helicopter::showRadarSweep(*snapshot);
+    } else {
+        helicopter.performRadarSweep(enemies, getEnemyGrid(), environment.getCurrentWeather());
+    }
 }
 
 void Game::showNavigationMap() {
@@ -374,15 +1166,34 @@ void Game::showNavigationMap() {
               << helicopter.getFlightParams().fuel << " liters" << std::endl;
     std::cout << "Speed: " << helicopter.getFlightParams().speed << " km/h" << std::endl;
     
+    // Areas the helicopter is in
+    const Position& here = helicopter.getPosition();
+    std::vector<size_t> envelopes;
+    getEngagementEnvelopes().queryPoint(here.x, here.y, ZONE_ENGAGEMENT, envelopes);
+    if (!envelopes.empty()) {
+        std::cout << "WARNING: Within reach of " << envelopes.size() << " enemy weapon(s)" << std::endl;
+    }
+    if (currentMission && currentMission->isInNoFlyZone(here)) {
+        std::cout << "WARNING: Inside a no-fly zone" << std::endl;
+    }
+    if (currentMission && currentMission->isInThreatArea(here)) {
+        std::cout << "Inside a known threat area" << std::endl;
+    }
+    
     // Show nearby contacts for reference
     if (!enemies.empty()) {
         std::cout << "\nNearby Contacts:" << std::endl;
+        const RelativeGeometry& geometry = getEnemyGeometry();
         for (size_t i = 0; i < std::min(enemies.size(), size_t(5)); ++i) {
-            double distance = helicopter.calculateDistance(enemies[i].getPosition());
-            double bearing = helicopter.calculateBearing(enemies[i].getPosition());
+            double distance = geometry.getRange(i);
+            double bearing = geometry.getBearing(i);
             std::cout << "  " << (i + 1) << ". " << enemies[i].getType() 
                       << " at " << std::fixed << std::setprecision(1) << distance 
-                      << "km, bearing " << std::fixed << std::setprecision(0) << bearing << " deg" << std::endl;
+                      << "km, bearing " << std::fixed << std::setprecision(0) << bearing << " deg";
+            if (geometry.getClosureRate(i) > 1.0) {
+                std::cout << ", closing " << geometry.getClosureRate(i) << " km/h";
+            }
+            std::cout << std::endl;
         }
     }
     
@@ -399,7 +1210,7 @@ void Game::showNavigationMap() {
     std::cout << "Enter your choice: ";
     
     int choice;
-    std::cin >> choice;
+    choice = readChoice();
     
     switch (choice) {
         case 1: moveHelicopter(0, 5); break;
@@ -424,7 +1235,7 @@ void Game::handleEmergency() {
     std::cout << "0. Cancel" << std::endl;
     
     int choice;
-    std::cin >> choice;
+    choice = readChoice();
     
     switch (choice) {
         case 1:
@@ -437,16 +1248,16 @@ void Game::handleEmergency() {
             std::cout << "Support request transmitted." << std::endl;
             break;
         case 4:
-            if (currentMission) {
-                currentMission->abort();
-            }
-            gameState = GameState::MAIN_MENU;
+            abortMission();
             break;
     }
 }
 
 void Game::showMissionStatus() {
-    if (currentMission) {
+    SnapshotPublisher::Handle snapshot = snapshots.acquire();
+    if (snapshot && snapshot->mission.active) {
+        Mission::showMissionStatus(snapshot->mission);
+    } else if (currentMission) {
         currentMission->showMissionStatus();
     } else {
         std::cout << "No active mission." << std::endl;
@@ -468,20 +1279,44 @@ void Game::showSimulationControls() {
     std::cout << "3. Toggle Real-time Mode" << std::endl;
     std::cout << "4. Weather Control" << std::endl;
     std::cout << "5. Debug Information" << std::endl;
+    std::cout << "6. Timestep Settings" << std::endl;
+    std::cout << "7. Worker Threads" << std::endl;
+    std::cout << "8. Level of Detail" << std::endl;
+    std::cout << "9. Tick Budget Governor" << std::endl;
     std::cout << "0. Back" << std::endl;
     
     int choice;
-    std::cin >> choice;
+    choice = readChoice();
     
     switch (choice) {
         case 1:
-            pausedState = !pausedState;
+            if (pausedState) {
+                resumeSimulation();
+            } else {
+                pauseSimulation();
+            }
             std::cout << "Simulation " << (pausedState ? "paused" : "resumed") << std::endl;
             break;
-        case 2:
-            std::cout << "Enter time acceleration (1.0 = real-time): ";
-            std::cin >> timeAcceleration;
+        case 2: {
+            std::cout << "1. Real-time (1x)" << std::endl;
+            std::cout << "2. Fast (10x)" << std::endl;
+            std::cout << "3. Very fast (100x)" << std::endl;
+            std::cout << "4. Custom acceleration" << std::endl;
+            int speedChoice;
+            speedChoice = readChoice();
+            switch (speedChoice) {
+                case 1: setSimulationSpeed(SimulationSpeed::REAL_TIME); break;
+                case 2: setSimulationSpeed(SimulationSpeed::FAST); break;
+                case 3: setSimulationSpeed(SimulationSpeed::VERY_FAST); break;
+                case 4:
+                    std::cout << "Enter time acceleration (1.0 = real-time): ";
+                    timeAcceleration = readNumber();
+                    timeAcceleration = std::max(0.0, timeAcceleration);
+                    break;
+            }
+            std::cout << "Time acceleration: " << timeAcceleration << "x" << std::endl;
             break;
+        }
         case 3:
             toggleRealTime();
             std::cout << "Real-time mode " << (realTimeMode ? "enabled" : "disabled") << std::endl;
@@ -492,6 +1327,61 @@ void Game::showSimulationControls() {
         case 5:
             showDebugInfo();
             break;
+        case 6: {
+            double stepMs, budgetMs;
+            std::cout << "Enter simulation step (ms, currently " << simClock.getStepSize() * 1000.0 << "): ";
+            stepMs = readNumber();
+            std::cout << "Enter CPU budget per frame (ms, currently " << simClock.getCpuBudget() << "): ";
+            budgetMs = readNumber();
+            simClock.setStepSize(stepMs / 1000.0);
+            simClock.setCpuBudget(budgetMs);
+            break;
+        }
+        case 7: {
+            std::cout << "Enter worker threads (0 = single-threaded, currently " << getWorkerThreads() << "): ";
+            int workers = static_cast<int>(readNumber());
+            setWorkerThreads(workers);
+            std::cout << "Enable phase race checking? (1 = yes, 0 = no): ";
+            tickGraph.setRaceChecking(readChoice() == 1);
+            std::cout << "Double-buffer world state? (1 = yes, 0 = no): ";
+            setDoubleBuffering(readChoice() == 1);
+            std::cout << "Worker threads: " << getWorkerThreads()
+                      << ", race checking " << (tickGraph.isRaceChecking() ? "on" : "off")
+                      << ", double buffering " << (doubleBuffered ? "on" : "off") << std::endl;
+            break;
+        }
+        case 8: {
+            std::cout << "Enable distance-based level of detail? (1 = yes, 0 = no): ";
+            setLodEnabled(readChoice() == 1);
+            if (lodSettings.enabled) {
+                std::cout << "Every-tick range (km, currently " << lodSettings.nearRange << "): ";
+                lodSettings.nearRange = std::max(0.0, readNumber());
+                std::cout << "Every-" << lodSettings.nearInterval << "th-tick range (km, currently "
+                          << lodSettings.farRange << "): ";
+                lodSettings.farRange = std::max(lodSettings.nearRange, readNumber());
+            }
+            std::cout << "Let idle enemies go dormant? (1 = yes, 0 = no): ";
+            setDormancyEnabled(readChoice() == 1);
+            std::cout << "Level of detail " << (lodSettings.enabled ? "on" : "off")
+                      << ", dormancy " << (dormancyEnabled ? "on" : "off") << std::endl;
+            break;
+        }
+        case 9: {
+            std::cout << "Enable tick budget governor? (1 = yes, 0 = no): ";
+            bool enable = readChoice() == 1;
+            if (!enable && governor.getLevel() != FidelityLevel::FULL) {
+                applyFidelity(governor.getLevel(), FidelityLevel::FULL);
+                std::cout << "[GOVERNOR] Restoring " << fidelityLevelName(FidelityLevel::FULL) << std::endl;
+            }
+            if (!enable) governor.reset();
+            governor.setEnabled(enable);
+            if (enable) {
+                std::cout << "Enter tick budget (ms, currently " << governor.getBudget() << "): ";
+                governor.setBudget(readNumber());
+            }
+            std::cout << "Governor " << (governor.isEnabled() ? "on" : "off") << std::endl;
+            break;
+        }
     }
 }
 
@@ -500,7 +1390,60 @@ void Game::showDebugInfo() {
     std::cout << "Game Time: " << std::fixed << std::setprecision(1) << gameTime << "s" << std::endl;
     std::cout << "Delta Time: " << deltaTime << "s" << std::endl;
     std::cout << "Time Acceleration: " << timeAcceleration << "x" << std::endl;
-    std::cout << "Enemies: " << enemies.size() << std::endl;
+    std::cout << "Simulation Step: " << std::setprecision(3) << simClock.getStepSize() << "s" << std::endl;
+    std::cout << "Substeps Last Frame: " << simClock.getFrameSteps()
+              << (simClock.isFallingBehind() ? " (CPU budget exceeded)" : "") << std::endl;
+    std::cout << "Backlog: " << simClock.getBacklog() << "s, dropped: " << simClock.getDroppedTime() << "s" << std::endl;
+    std::cout << "Tick Cost: " << std::setprecision(3) << lastTickMs << " ms";
+    if (governor.isEnabled()) {
+        std::cout << ", average " << governor.getAverageMs() << " ms of " << governor.getBudget()
+                  << " ms budget - " << fidelityLevelName(governor.getLevel());
+    }
+    std::cout << std::endl;
+    long long decisions = governor.getDecisionCount();
+    for (long long i = std::max(0LL, decisions - 3); i < decisions; ++i) {
+        const GovernorDecision& decision = governor.getHistory()[i % governor.getHistory().size()];
+        std::cout << "  tick " << decision.tick << ": " << fidelityLevelName(decision.from) << " -> "
+                  << fidelityLevelName(decision.to) << " (slowest '" << decision.slowestPhase << "')" << std::endl;
+    }
+    std::cout << "Tick Allocations: " << lastTickAllocations.count << " ("
+              << lastTickAllocations.bytes << " bytes)";
+    for (int i = 0; i < static_cast<int>(tickGraph.getTaskCount()); ++i) {
+        const AllocationStats& phase = tickGraph.getTaskAllocations(i);
+        if (phase.count > 0) {
+            std::cout << ", " << tickGraph.getTaskName(i) << " " << phase.count;
+        }
+    }
+    std::cout << std::endl;
+    std::cout << "Worker Threads: " << getWorkerThreads()
+              << (doubleBuffered ? " (double-buffered)" : "") << std::endl;
+    if (tickGraph.isRaceChecking()) {
+        std::cout << "Race Violations: " << tickGraph.getRaceViolations() << std::endl;
+    }
+    std::cout << "Mission Arena: " << missionArena.getBytesAllocated() << " bytes in "
+              << missionArena.getAllocationCount() << " allocations, "
+              << missionArena.getReleaseCount() << " releases" << std::endl;
+    std::cout << "Enemies: " << enemies.size();
+    if (dormancyEnabled && activeEnemies.size() == enemies.size()) {
+        std::cout << " (" << activeEnemies.getActive().size() << " awake, "
+                  << activeEnemies.getDormantCount() << " dormant)";
+    }
+    std::cout << std::endl;
+    std::cout << "Geometry Rebuilds: " << enemyGeometry.getRebuilds() << " in " << tickCount << " ticks" << std::endl;
+    std::cout << "Spatial Grid: " << enemyGrid.getRebuilds() << " rebuilds, " << enemyGrid.getMoves()
+              << " cell moves" << std::endl;
+    std::cout << "Engagement Envelopes: " << engagementEnvelopes.getRebuilds() << " rebuilds" << std::endl;
+    if (lodSettings.enabled) {
+        int full = 0, near = 0, far = 0;
+        for (const auto& enemy : enemies) {
+            int interval = enemy.getLodState().interval;
+            if (interval <= 1) full++;
+            else if (interval <= lodSettings.nearInterval) near++;
+            else far++;
+        }
+        std::cout << "LOD Tiers: " << full << " every tick, " << near << " every "
+                  << lodSettings.nearInterval << ", " << far << " every " << lodSettings.farInterval << std::endl;
+    }
     std::cout << "Helicopter Alive: " << (helicopter.isAlive() ? "Yes" : "No") << std::endl;
 }
 
@@ -522,20 +1465,24 @@ void Game::selectWeapon() {
 }
 
 void Game::showFlightInterface() {
+    SnapshotPublisher::Handle snapshot = snapshots.acquire();
+    if (!snapshot) return;
+    
+    const HelicopterSnapshot& heli = snapshot->helicopter;
     std::cout << "\n=== FLIGHT INTERFACE ===" << std::endl;
-    std::cout << "Time: " << formatTime(gameTime) << std::endl;
+    std::cout << "Time: " << formatTime(snapshot->gameTime) << std::endl;
     std::cout << "Position: (" << std::fixed << std::setprecision(1)
-              << helicopter.getPosition().x << ", " << helicopter.getPosition().y 
-              << ") Alt: " << helicopter.getPosition().altitude << "m" << std::endl;
+              << heli.position.x << ", " << heli.position.y 
+              << ") Alt: " << heli.position.altitude << "m" << std::endl;
     std::cout << "Fuel: " << std::fixed << std::setprecision(0) 
-              << helicopter.getFlightParams().fuel << "/" 
-              << helicopter.getFlightParams().maxFuel << "L" << std::endl;
-    std::cout << "Enemies: " << enemies.size() << " contacts" << std::endl;
+              << heli.flightParams.fuel << "/" 
+              << heli.flightParams.maxFuel << "L" << std::endl;
+    std::cout << "Enemies: " << snapshot->enemies.size() << " contacts" << std::endl;
     
-    if (currentMission) {
-        std::cout << "Mission: " << currentMission->getName() << std::endl;
+    if (snapshot->mission.active) {
+        std::cout << "Mission: " << snapshot->mission.name << std::endl;
         std::cout << "Progress: " << std::fixed << std::setprecision(0) 
-                  << currentMission->getProgress() * 100 << "%" << std::endl;
+                  << snapshot->mission.progress * 100 << "%" << std::endl;
     }
 }
 
@@ -547,49 +1494,81 @@ void Game::showMissionBriefing() {
     }
 }
 
+// Both fit the string's inline buffer, so neither touches the heap
 std::string Game::formatTime(double seconds) const {
     int minutes = static_cast<int>(seconds) / 60;
     int secs = static_cast<int>(seconds) % 60;
-    std::stringstream ss;
-    ss << std::setfill('0') << std::setw(2) << minutes << ":" 
-       << std::setfill('0') << std::setw(2) << secs;
-    return ss.str();
+    char text[16];
+    std::snprintf(text, sizeof(text), "%02d:%02d", minutes, secs);
+    return text;
 }
 
 std::string Game::formatDistance(double km) const {
+    char text[16];
     if (km < 1.0) {
-        return std::to_string(static_cast<int>(km * 1000)) + "m";
+        std::snprintf(text, sizeof(text), "%dm", static_cast<int>(km * 1000));
     } else {
-        std::stringstream ss;
-        ss << std::fixed << std::setprecision(1) << km << "km";
-        return ss.str();
+        std::snprintf(text, sizeof(text), "%.1fkm", km);
     }
+    return text;
 }
 
 // Movement helper functions
 void Game::moveHelicopter(double deltaX, double deltaY) {
     Position currentPos = helicopter.getPosition();
     Position newPos(currentPos.x + deltaX, currentPos.y + deltaY, currentPos.altitude);
+    double distance = simDistance(deltaX, deltaY);
     
-    // Calculate fuel consumption for movement
-    double distance = sqrt(deltaX * deltaX + deltaY * deltaY);
-    double fuelNeeded = distance * 2.0; // 2 liters per km
+    FlightParams params = helicopter.getFlightParams();
+    if (params.speed <= 0.0) {
+        params.speed = 150.0; // Cruise speed
+        helicopter.setFlightParams(params);
+        std::cout << "Setting cruise speed " << params.speed << " km/h" << std::endl;
+    }
+    
+    // Estimate fuel for the leg at the current burn rate
+    double transitTime = distance / (params.speed / 3600.0);
+    double fuelNeeded = helicopter.getFuelFlowRate() * transitTime;
     
     if (helicopter.getFlightParams().fuel < fuelNeeded) {
         std::cout << "Insufficient fuel for this movement!" << std::endl;
         return;
     }
     
-    helicopter.setPosition(newPos);
-    helicopter.consumeFuel(fuelNeeded);
+    // What the leg flies through
+    if (currentMission && currentMission->routeCrossesNoFlyZone(currentPos, newPos)) {
+        std::cout << "WARNING: Route crosses a no-fly zone" << std::endl;
+    }
+    std::vector<size_t> envelopes;
+    getEngagementEnvelopes().querySegment(currentPos.x, currentPos.y, newPos.x, newPos.y, ZONE_ENGAGEMENT, envelopes);
+    if (!envelopes.empty()) {
+        std::cout << "Route passes within reach of " << envelopes.size() << " enemy weapon(s)" << std::endl;
+    }
+    
+    double startFuel = helicopter.getFlightParams().fuel;
+    double startTime = gameTime;
+    
+    // Fly the leg with the world running, skipping ahead between events
+    helicopter.setDestination(newPos);
+    SimEvent stop = fastForward(transitTime + simClock.getStepSize());
     
-    std::cout << "Moved to position (" << std::fixed << std::setprecision(1) 
-              << newPos.x << ", " << newPos.y << ")" << std::endl;
+    const Position& pos = helicopter.getPosition();
+    if (stop.type == SimEventType::DESTINATION_REACHED || stop.type == SimEventType::DURATION_LIMIT) {
+        std::cout << "Moved to position (" << std::fixed << std::setprecision(1) 
+                  << pos.x << ", " << pos.y << ")" << std::endl;
+    } else {
+        std::cout << "*** TRANSIT INTERRUPTED: " << simEventName(stop.type);
+        if (stop.subject >= 0 && stop.subject < static_cast<int>(enemies.size())) {
+            std::cout << " (" << enemies[stop.subject].getType() << ")";
+        }
+        std::cout << " ***" << std::endl;
+        std::cout << "Holding at position (" << std::fixed << std::setprecision(1) 
+                  << pos.x << ", " << pos.y << ")" << std::endl;
+        helicopter.setDestination(pos);
+    }
     std::cout << "Fuel consumed: " << std::fixed << std::setprecision(1) 
-              << fuelNeeded << " liters" << std::endl;
-              
-    // Advance time for movement
-    gameTime += distance * 60.0 / helicopter.getFlightParams().maxSpeed; // Time based on max speed
+              << startFuel - helicopter.getFlightParams().fuel << " liters" << std::endl;
+    std::cout << "Transit time: " << formatTime(gameTime - startTime) << std::endl;
 }
 
 void Game::moveToContact() {
@@ -598,31 +1577,44 @@ void Game::moveToContact() {
         return;
     }
     
+    // The ten closest, held by handle while the world ticks under the menu
+    const Position& here = helicopter.getPosition();
+    std::vector<size_t> closest;
+    getEnemyGrid().queryNearest(here.x, here.y, 10, closest);
+    const RelativeGeometry& geometry = getEnemyGeometry();
+    std::vector<EnemyHandle> handles;
+    
     std::cout << "\nSelect contact to move towards:" << std::endl;
-    for (size_t i = 0; i < std::min(enemies.size(), size_t(10)); ++i) {
-        double distance = helicopter.calculateDistance(enemies[i].getPosition());
-        std::cout << (i + 1) << ". " << enemies[i].getType() 
+    for (size_t k = 0; k < closest.size(); ++k) {
+        double distance = geometry.getRange(closest[k]);
+        std::cout << (k + 1) << ". " << enemies[closest[k]].getType() 
                   << " (" << std::fixed << std::setprecision(1) << distance << "km)" << std::endl;
+        handles.push_back(enemies.getHandle(closest[k]));
     }
     std::cout << "0. Cancel" << std::endl;
     std::cout << "Enter choice: ";
     
     int choice;
-    std::cin >> choice;
+    choice = readChoice();
     
-    if (choice == 0 || choice > static_cast<int>(enemies.size())) {
+    if (choice <= 0 || choice > static_cast<int>(handles.size())) {
+        return;
+    }
+    int target = enemies.indexOf(handles[choice - 1]);
+    if (target < 0) {
+        std::cout << "Contact lost." << std::endl;
         return;
     }
     
-    Position enemyPos(enemies[choice - 1].getPosition().x, 
-                      enemies[choice - 1].getPosition().y,
-                      enemies[choice - 1].getPosition().altitude);
+    Position enemyPos(enemies[target].getPosition().x, 
+                      enemies[target].getPosition().y,
+                      enemies[target].getPosition().altitude);
     Position currentPos = helicopter.getPosition();
     
     // Move to within 2km of target for safety
     double deltaX = enemyPos.x - currentPos.x;
     double deltaY = enemyPos.y - currentPos.y;
-    double distance = sqrt(deltaX * deltaX + deltaY * deltaY);
+    double distance = simDistance(deltaX, deltaY);
     
     if (distance <= 2.0) {
         std::cout << "Already within engagement range of target." << std::endl;
@@ -640,9 +1632,9 @@ void Game::moveToContact() {
 void Game::setCustomWaypoint() {
     double x, y;
     std::cout << "Enter X coordinate: ";
-    std::cin >> x;
+    x = readNumber();
     std::cout << "Enter Y coordinate: ";
-    std::cin >> y;
+    y = readNumber();
     
     Position currentPos = helicopter.getPosition();
     double deltaX = x - currentPos.x;
@@ -660,7 +1652,7 @@ void Game::changeAltitude() {
     std::cout << "Enter choice: ";
     
     int choice;
-    std::cin >> choice;
+    choice = readChoice();
     
     Position currentPos = helicopter.getPosition();
     Position newPos = currentPos;
@@ -674,7 +1666,7 @@ void Game::changeAltitude() {
             break;
         case 3:
             std::cout << "Enter altitude (10-3000m): ";
-            std::cin >> newPos.altitude;
+            newPos.altitude = readNumber();
             newPos.altitude = std::max(10.0, std::min(newPos.altitude, 3000.0));
             break;
         case 0:
@@ -699,7 +1691,7 @@ void Game::adjustSpeed() {
     std::cout << "Enter choice: ";
     
     int choice;
-    std::cin >> choice;
+    choice = readChoice();
     
     FlightParams params = helicopter.getFlightParams();
     
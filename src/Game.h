@@ -1,8 +1,23 @@
 #pragma once
 #include "Helicopter.h"
-#include "Enemy.h"
+#include "EnemyStore.h"
 #include "Mission.h"
 #include "Environment.h"
+#include "Scenario.h"
+#include "SimulationClock.h"
+#include "EventQueue.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
+#include "TaskGraph.h"
+#include "SimulationLod.h"
+#include "ActiveSet.h"
+#include "TickGovernor.h"
+#include "RandomService.h"
+#include "MissionArena.h"
+#include "SpatialOrder.h"
+#include "RelativeGeometry.h"
+#include "SpatialGrid.h"
+#include "ZoneIndex.h"
 #include <vector>
 #include <memory>
 #include <chrono>
@@ -23,6 +38,20 @@ enum class SimulationSpeed {
     PAUSED
 };
 
+// Outcome of a single mission, reported by headless batch runs
+struct MissionResult {
+    MissionType missionType;
+    MissionStatus status;
+    int score;
+    std::string rating;
+    double simTime;            // seconds
+    long long ticks;
+    int enemiesDestroyed;
+    int enemiesRemaining;
+    double helicopterHealth;
+    double fuelRemaining;      // liters
+};
+
 class Game {
 public:
     Game();
@@ -56,6 +85,7 @@ public:
     void performRadarScan();
     void showNavigationMap();
     void handleEmergency();
+    SimEvent fastForward(double maxDuration);
     
     // Combat system
     void engageEnemy();
@@ -82,17 +112,73 @@ public:
     void showTacticalDisplay();
     void showDebugInfo();
     
+    // Published state for observers on any thread
+    const SnapshotPublisher& getSnapshots() const { return snapshots; }
+    void setSnapshotPublishing(bool enabled) { publishSnapshots = enabled; }
+    void publishSnapshot();
+    
+    // Parallel tick phases (0 workers = run phases inline on the caller)
+    void setWorkerThreads(int count);
+    int getWorkerThreads() const;
+    static int defaultWorkerThreads();
+    // indices limits the pass to those enemies (nullptr = everyone)
+    static void updateEnemyPopulation(EnemyStore& enemies, double dt, ThreadPool* pool,
+                                      const LodFrame* lod = nullptr,
+                                      const std::vector<size_t>* indices = nullptr);
+    static void advanceEnemyPopulation(const EnemyStore& current, EnemyStore& next, double dt,
+                                       ThreadPool* pool, const LodFrame* lod = nullptr,
+                                       const std::vector<size_t>* indices = nullptr);
+    
+    // Double-buffered ticks: phases read last tick's world and write the next one
+    void setDoubleBuffering(bool enabled);
+    bool isDoubleBuffering() const { return doubleBuffered; }
+    
+    // Distance-based level of detail for enemy updates
+    void setLodEnabled(bool enabled);
+    const LodSettings& getLodSettings() const { return lodSettings; }
+    
+    // Idle enemies sleep until something wakes them
+    void setDormancyEnabled(bool enabled);
+    bool isDormancyEnabled() const { return dormancyEnabled; }
+    void wakeEnemy(int enemyIndex);
+    
+    // Large populations are kept sorted along a space-filling curve
+    void setSpatialOrdering(bool enabled) { spatialOrdering = enabled; }
+    bool isSpatialOrdering() const { return spatialOrdering; }
+    void setRaceChecking(bool enabled) { tickGraph.setRaceChecking(enabled); }
+    int getRaceViolations() const { return tickGraph.getRaceViolations(); }
+    const AllocationStats& getTickAllocations() const { return lastTickAllocations; }
+    
+    // Helicopter-to-enemy range, bearing and closure, rebuilt at most once a tick
+    const RelativeGeometry& getEnemyGeometry() const;
+    // Enemy positions bucketed for range and nearest queries, refreshed at most once a tick
+    const SpatialGrid& getEnemyGrid() const;
+    // Weapon reach of every armed enemy, rebuilt at most once a tick
+    const ZoneIndex& getEngagementEnvelopes() const;
+    const TaskGraph& getTickGraph() const { return tickGraph; }
+    
+    // Console input - in real-time mode the simulation keeps ticking while waiting
+    int readChoice();
+    double readNumber();
+    
     // Game state management
     GameState getGameState() const { return gameState; }
     void setGameState(GameState state) { gameState = state; }
     bool isGameRunning() const { return gameRunning; }
     void exitGame() { gameRunning = false; }
+    
+    // Headless simulation (no menus, autopilot flies the mission)
+    void startHeadlessMission(const ScenarioConfig& config, unsigned int seed);
+    void stepSimulation();
+    bool isSimulationFinished() const;
+    MissionResult getMissionResult() const;
 
 private:
     // Core game objects
     Helicopter helicopter;
-    std::vector<Enemy> enemies;
-    std::unique_ptr<Mission> currentMission;
+    EnemyStore enemies;
+    MissionArena missionArena;          // released wholesale when the next mission is created
+    ArenaPtr<Mission> currentMission;
     Environment environment;
     
     // Game state
@@ -106,17 +192,74 @@ private:
     double deltaTime;           // seconds
     double gameTime;           // total elapsed time
     double missionTime;        // time since mission start
+    SimulationClock simClock;  // fixed-step accumulator
+    EventQueue eventQueue;     // upcoming events for fast-forward
     
     // Simulation parameters
     double timeAcceleration;   // 1.0 = real-time, higher = faster
     bool pausedState;
     
+    // Headless autopilot
+    bool autopilotEnabled;
+    ScenarioConfig scenario;
+    double engagementTimer;    // seconds since last autopilot attack
+    int enemiesDestroyed;
+    long long tickCount;
+    bool readingInput;         // a menu is waiting on console input
+    
+    // Per-tick state publication
+    SnapshotPublisher snapshots;
+    bool publishSnapshots;
+    
+    // Per-tick task graph
+    std::unique_ptr<ThreadPool> workerPool;
+    TaskGraph tickGraph;
+    double phaseDeltaTime;     // dt of the tick the graph is running
+    
+    // Back buffers written during a double-buffered tick, swapped in at its end
+    bool doubleBuffered;
+    Helicopter nextHelicopter;
+    EnemyStore nextEnemies;
+    Environment nextEnvironment;
+    
+    LodSettings lodSettings;
+    
+    // Awake enemies; dormant ones are skipped by the tick and counterattacks
+    bool dormancyEnabled;
+    ActiveSet activeEnemies;
+    std::vector<SimEvent> dueWakes;   // scratch for the wake pass
+    std::vector<size_t> newlyDormant; // slept this tick, copied to the back buffer at the swap
+    
+    // Memory order of the enemies, re-sorted a slice per tick
+    bool spatialOrdering;
+    SpatialOrder spatialOrder;
+    
+    // Shared by radar, navigation and combat; filled on first use after a tick
+    mutable RelativeGeometry enemyGeometry;
+    mutable SpatialGrid enemyGrid;
+    mutable ZoneIndex engagementEnvelopes;
+    
+    // Deterministic random draws keyed by entity, tick and purpose
+    RandomService random;
+    EntityId nextEntityId;
+    
+    // Real-time tick budget
+    TickGovernor governor;
+    double lastTickMs;               // wall time of the last updateGameLogic
+    AllocationStats lastTickAllocations;   // heap allocations of the last updateGameLogic, all threads
+    int weatherInterval;             // ticks between environment updates
+    double pendingWeatherTime;       // seconds not yet applied to the environment
+    bool environmentUpdated;         // environment phase wrote the back buffer this tick
+    LodSettings baseLodSettings;     // settings to restore when fidelity recovers
+    double baseStepSize;
+    
     // UI and display
     bool showDebugMode;
     bool showAdvancedInfo;
     
     // Input handling
     void processInput();
+    bool readToken(std::string& token);
     void handleMenuNavigation();
     bool validateInput(int choice, int minChoice, int maxChoice);
     void clearInputBuffer();
@@ -128,15 +271,26 @@ private:
     void updateEnemies(double deltaTime);
     void updateEnvironment(double deltaTime);
     void updateCombat(double deltaTime);
+    void updateAutopilot(double deltaTime);
+    void scheduleEvents(EventQueue& queue, double horizon) const;
+    void buildTickGraph();
+    void swapWorldBuffers();
+    void syncActiveEnemies();
+    void wakeDueEnemies();
+    void sleepIdleEnemies(EnemyStore& updated);
+    void reorderEnemies();
+    void governTick();
+    void applyFidelity(FidelityLevel from, FidelityLevel to);
     
     // Mission generation
+    void createMission(MissionType type);
     void generateRandomMission();
     void generateEnemies(MissionType type, int difficulty);
-    std::vector<Enemy> createEnemyFormation(EnemyType type, int count, 
-                                          const EnemyPosition& centerPos);
+    void createEnemyFormation(EnemyType type, int count, const EnemyPosition& centerPos);
     
     // Helper methods
     double calculateDeltaTime();
+    double getSpeedMultiplier(SimulationSpeed speed) const;
     void resetGame();
     void initializeHelicopter();
     void setupDefaultWeapons();
@@ -1,14 +1,12 @@
 #include <iostream>
-#include <random>
 #include <iomanip>
 #include <cmath>
 
-// Define M_PI for Windows compatibility
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 #include "Helicopter.h"
+#include "Snapshot.h"
+#include "SimMath.h"
+#include "SpatialGrid.h"
+#include "DetectionKernel.h"
 
 Helicopter::Helicopter(const std::string& name) 
     : name(name), health(100.0), position(0, 0, 100), 
@@ -42,7 +40,7 @@ Helicopter::Helicopter(const std::string& name)
 
 Helicopter::Helicopter() : Helicopter("AH-64 Apache") {}
 
-void Helicopter::attack(Enemy& target) {
+void Helicopter::attack(Enemy target, const RandomService& random) {
     if (weapons.empty()) {
         std::cout << name << " has no weapons to attack " << target.getType() << "!" << std::endl;
         return;
@@ -52,13 +50,13 @@ void Helicopter::attack(Enemy& target) {
     for (size_t i = 0; i < weapons.size(); ++i) {
         if (weapons[i].hasAmmo()) {
             double distance = 2.0; // Assume 2km for basic attack
-            attackWithWeapon(target, static_cast<int>(i), distance);
+            attackWithWeapon(target, static_cast<int>(i), distance, random);
             break;
         }
     }
 }
 
-bool Helicopter::attackWithWeapon(Enemy& target, int weaponIndex, double distance) {
+bool Helicopter::attackWithWeapon(Enemy target, int weaponIndex, double distance, const RandomService& random) {
     if (weaponIndex < 0 || weaponIndex >= static_cast<int>(weapons.size())) {
         std::cout << "Invalid weapon selection." << std::endl;
         return false;
@@ -85,14 +83,11 @@ bool Helicopter::attackWithWeapon(Enemy& target, int weaponIndex, double distanc
     double hitChance = weapon.calculateHitProbability(distance, 0.0, 1.0);
     hitChance *= systems.radarHealth; // Degraded systems reduce accuracy
     
-    std::random_device rd;
-    std::mt19937 rng(rd());
-    std::uniform_real_distribution<double> hitRoll(0.0, 1.0);
-    
     weapon.consumeAmmo();
     
-    if (hitRoll(rng) <= hitChance) {
-        int damage = weapon.getDamage();
+    uint32_t slot = static_cast<uint32_t>(weaponIndex);
+    if (random.uniform(random.key(PLAYER_ENTITY, RandomPurpose::WEAPON_HIT, slot)) <= hitChance) {
+        int damage = weapon.getDamage(random, random.key(PLAYER_ENTITY, RandomPurpose::WEAPON_DAMAGE, slot));
         damage = static_cast<int>(damage * weapon.calculateDamageAtRange(distance));
         
         std::cout << name << " successfully hits " << target.getType()
@@ -182,7 +177,7 @@ void Helicopter::updatePosition(double deltaTime) {
         double dy = destination.y - position.y;
         double dalt = destination.altitude - position.altitude;
         
-        double distance = sqrt(dx*dx + dy*dy + dalt*dalt);
+        double distance = simDistance(dx, dy, dalt);
         
         if (distance > 0.1) { // 100m threshold
             double moveDistance = (flightParams.speed / 3600.0) * deltaTime; // km
@@ -193,37 +188,39 @@ void Helicopter::updatePosition(double deltaTime) {
             position.altitude += dalt * ratio;
         }
     }
+}
+
+double Helicopter::getFuelFlowRate() const {
+    // Mirrors updateFuel(): base burn scaled by engine damage and speed
+    double rate = flightParams.fuelConsumption / 60.0;
+    rate *= (2.0 - systems.engineHealth);
+    rate *= (1.0 + flightParams.speed / flightParams.maxSpeed);
+    return rate;
+}
+
+double Helicopter::getTimeToDestination() const {
+    if (isHovering || flightParams.speed <= 0 || !canFly()) return -1.0;
     
-    // Update position based on current speed
-    if (flightParams.speed > 0 && destination.x != position.x && destination.y != position.y) {
-        double dx = destination.x - position.x;
-        double dy = destination.y - position.y;
-        double distance = sqrt(dx*dx + dy*dy);
-        
-        if (distance > 0.1) { // 100m threshold
-            double moveDistance = (flightParams.speed / 3600.0) * deltaTime; // km
-            double ratio = std::min(1.0, moveDistance / distance);
-            
-            position.x += dx * ratio;
-            position.y += dy * ratio;
-        }
-    }
+    double dx = destination.x - position.x;
+    double dy = destination.y - position.y;
+    double dalt = destination.altitude - position.altitude;
+    double distance = simDistance(dx, dy, dalt);
+    if (distance <= 0.1) return -1.0;
+    
+    return distance / (flightParams.speed / 3600.0);
 }
 
 // Utility methods for navigation
 double Helicopter::calculateDistance(const EnemyPosition& enemyPos) const {
     double dx = enemyPos.x - position.x;
     double dy = enemyPos.y - position.y;
-    return std::sqrt(dx * dx + dy * dy);
+    return simDistance(dx, dy);
 }
 
 double Helicopter::calculateBearing(const EnemyPosition& enemyPos) const {
     double dx = enemyPos.x - position.x;
     double dy = enemyPos.y - position.y;
-    double bearing = std::atan2(dy, dx) * 180.0 / M_PI;
-    // Convert to 0-360 range
-    if (bearing < 0) bearing += 360.0;
-    return bearing;
+    return simBearing(dx, dy);
 }
 
 void Helicopter::updateFuel(double deltaTime) {
@@ -248,39 +245,45 @@ void Helicopter::updateFuel(double deltaTime) {
     }
 }
 
-double Helicopter::detectEnemy(const Enemy& enemy, WeatherCondition weather) const {
+double Helicopter::detectEnemy(const EnemyView& enemy, WeatherCondition weather) const {
     if (!systems.radar) return 0.0;
     
     // Calculate distance to enemy
     double dx = enemy.getPosition().x - position.x;
     double dy = enemy.getPosition().y - position.y;
-    double distance = sqrt(dx*dx + dy*dy);
+    double distance = simDistance(dx, dy);
     
+    return calculateDetection(distance, radarRange, systems.radarHealth, weather,
+                              enemy.getCapabilities().isAirborne);
+}
+
+double Helicopter::calculateDetection(double distance, double radarRange, double radarHealth,
+                                      WeatherCondition weather, bool airborneTarget) {
     // Base detection probability
-    double detectionChance = 1.0;
+    SimReal detectionChance = 1;
     
     // Range factor
     if (distance > radarRange) {
-        detectionChance = 0.0;
+        detectionChance = 0;
     } else {
-        detectionChance = 1.0 - (distance / radarRange);
+        detectionChance = SimReal(1) - static_cast<SimReal>(distance / radarRange);
     }
     
     // Weather effects
-    detectionChance *= calculateWeatherEffect(weather);
+    detectionChance *= static_cast<SimReal>(calculateWeatherEffect(weather));
     
     // System health effects
-    detectionChance *= systems.radarHealth;
+    detectionChance *= static_cast<SimReal>(radarHealth);
     
     // Enemy stealth factor (if applicable)
-    if (enemy.getCapabilities().isAirborne) {
-        detectionChance *= 0.7; // Airborne targets are harder to detect
+    if (airborneTarget) {
+        detectionChance *= SimReal(0.7); // Airborne targets are harder to detect
     }
     
     return detectionChance;
 }
 
-double Helicopter::calculateWeatherEffect(WeatherCondition weather) const {
+double Helicopter::calculateWeatherEffect(WeatherCondition weather) {
     switch (weather) {
         case WeatherCondition::CLEAR: return 1.0;
         case WeatherCondition::LIGHT_RAIN: return 0.9;
@@ -291,7 +294,8 @@ double Helicopter::calculateWeatherEffect(WeatherCondition weather) const {
     }
 }
 
-void Helicopter::performRadarSweep(const std::vector<Enemy>& enemies, WeatherCondition weather) const {
+void Helicopter::performRadarSweep(const EnemyStore& enemies, const SpatialGrid& grid,
+                                   WeatherCondition weather) const {
     if (!systems.radar) {
         std::cout << "Radar system offline!" << std::endl;
         return;
@@ -302,18 +306,24 @@ void Helicopter::performRadarSweep(const std::vector<Enemy>& enemies, WeatherCon
     std::cout << "Weather effect: " << std::fixed << std::setprecision(1) 
               << calculateWeatherEffect(weather) * 100 << "%" << std::endl;
     
+    // Nothing beyond radar range can be detected
+    std::vector<size_t> contacts;
+    grid.queryRadius(position.x, position.y, radarRange, contacts);
+    
+    DetectionBatch batch;
+    for (size_t i : contacts) {
+        const EnemyPosition& pos = enemies[i].getPosition();
+        batch.add(pos.x, pos.y, enemies[i].isAirTarget());
+    }
+    RadarParameters radar = { position.x, position.y, radarRange, systems.radarHealth, calculateWeatherEffect(weather) };
+    detectContacts(radar, batch);
+    
     int contactsDetected = 0;
-    for (const auto& enemy : enemies) {
-        double detectionChance = detectEnemy(enemy, weather);
-        if (detectionChance > 0.5) { // 50% threshold for positive detection
-            double dx = enemy.getPosition().x - position.x;
-            double dy = enemy.getPosition().y - position.y;
-            double distance = sqrt(dx*dx + dy*dy);
-            double bearing = atan2(dy, dx) * 180.0 / M_PI;
-            
-            std::cout << "Contact: " << enemy.getType() 
-                      << " at " << std::fixed << std::setprecision(1) << distance 
-                      << "km, bearing " << std::fixed << std::setprecision(0) << bearing << " deg" << std::endl;
+    for (size_t c = 0; c < contacts.size(); ++c) {
+        if (batch.probabilities[c] > 0.5) { // 50% threshold for positive detection
+            std::cout << "Contact: " << enemies[contacts[c]].getType() 
+                      << " at " << std::fixed << std::setprecision(1) << batch.ranges[c] 
+                      << "km, bearing " << std::fixed << std::setprecision(0) << batch.bearings[c] << " deg" << std::endl;
             contactsDetected++;
         }
     }
@@ -323,6 +333,55 @@ void Helicopter::performRadarSweep(const std::vector<Enemy>& enemies, WeatherCon
     }
 }
 
+// Same sweep as performRadarSweep, computed from a published snapshot
+void Helicopter::showRadarSweep(const WorldSnapshot& snapshot) {
+    const HelicopterSnapshot& self = snapshot.helicopter;
+    WeatherCondition weather = snapshot.environment.weather;
+    
+    if (!self.systems.radar) {
+        std::cout << "Radar system offline!" << std::endl;
+        return;
+    }
+    
+    std::cout << "\n=== RADAR SWEEP ===" << std::endl;
+    std::cout << "Range: " << self.radarRange << "km" << std::endl;
+    std::cout << "Weather effect: " << std::fixed << std::setprecision(1) 
+              << calculateWeatherEffect(weather) * 100 << "%" << std::endl;
+    
+    DetectionBatch batch;
+    for (const auto& enemy : snapshot.enemies) {
+        batch.add(enemy.position.x, enemy.position.y, enemy.isAirborne);
+    }
+    RadarParameters radar = { self.position.x, self.position.y, self.radarRange, self.systems.radarHealth,
+                              calculateWeatherEffect(weather) };
+    detectContacts(radar, batch);
+    
+    int contactsDetected = 0;
+    for (size_t c = 0; c < snapshot.enemies.size(); ++c) {
+        if (batch.probabilities[c] > 0.5) { // 50% threshold for positive detection
+            std::cout << "Contact: " << snapshot.enemies[c].type 
+                      << " at " << std::fixed << std::setprecision(1) << batch.ranges[c] 
+                      << "km, bearing " << std::fixed << std::setprecision(0) << batch.bearings[c] << " deg" << std::endl;
+            contactsDetected++;
+        }
+    }
+    
+    if (contactsDetected == 0) {
+        std::cout << "No contacts detected." << std::endl;
+    }
+}
+
+void Helicopter::fillSnapshot(HelicopterSnapshot& snapshot) const {
+    snapshot.name = name;
+    snapshot.position = position;
+    snapshot.flightParams = flightParams;
+    snapshot.systems = systems;
+    snapshot.health = health;
+    snapshot.radarRange = radarRange;
+    snapshot.flareCount = flareCount;
+    snapshot.chaffCount = chaffCount;
+}
+
 void Helicopter::showStatus() const {
     std::cout << "\n=== HELICOPTER STATUS ===" << std::endl;
     std::cout << "Aircraft: " << name << std::endl;
@@ -455,23 +514,21 @@ void Helicopter::performSystemCheck() const {
     }
 }
 
-void Helicopter::attackRandomEnemy(std::vector<Enemy>& enemies) {
+void Helicopter::attackRandomEnemy(EnemyStore& enemies, const RandomService& random) {
     if (enemies.empty()) {
         std::cout << "No enemies left to attack!\n";
         return;
     }
 
-    std::random_device rd;
-    std::mt19937 rng(rd());
-    std::uniform_int_distribution<int> dist(0, static_cast<int>(enemies.size()) - 1);
-    int randomIndex = dist(rng);
+    int randomIndex = random.uniformInt(0, static_cast<int>(enemies.size()) - 1,
+                                        random.key(PLAYER_ENTITY, RandomPurpose::TARGET_SELECTION));
 
-    attack(enemies[randomIndex]);
+    attack(enemies[randomIndex], random);
 
     // Remove defeated enemy
     if (enemies[randomIndex].getHealth() <= 0) {
         std::cout << enemies[randomIndex].getType() << " was destroyed!" << std::endl;
-        enemies.erase(enemies.begin() + randomIndex);
+        enemies.erase(randomIndex);
     }
 }
 
@@ -574,71 +631,13 @@ void Helicopter::initializeDefaultWeapons() {
     // Clear any existing weapons
     weapons.clear();
     
-    // Add default weapon loadout for combat helicopter
-    WeaponSpecs chainGunSpecs;
-    chainGunSpecs.range = 3.0;
-    chainGunSpecs.accuracy = 0.85;
-    chainGunSpecs.reloadTime = 1.0;
-    chainGunSpecs.penetration = 25.0;
-    chainGunSpecs.requiresLOS = true;
-    chainGunSpecs.blastRadius = 0.0;
-    chainGunSpecs.lockOnTime = 0.0;
-    
-    WeaponSpecs missileSpecs;
-    missileSpecs.range = 8.0;
-    missileSpecs.accuracy = 0.9;
-    missileSpecs.reloadTime = 3.0;
-    missileSpecs.penetration = 80.0;
-    missileSpecs.requiresLOS = true;
-    missileSpecs.blastRadius = 10.0;
-    missileSpecs.lockOnTime = 2.0;
-    
-    WeaponSpecs rocketSpecs;
-    rocketSpecs.range = 5.0;
-    rocketSpecs.accuracy = 0.75;
-    rocketSpecs.reloadTime = 2.0;
-    rocketSpecs.penetration = 50.0;
-    rocketSpecs.requiresLOS = true;
-    rocketSpecs.blastRadius = 15.0;
-    rocketSpecs.lockOnTime = 0.0;
-    
-    // Air-to-air missile specs (Sidewinder-type)
-    WeaponSpecs aaSpecs;
-    aaSpecs.range = 15.0;
-    aaSpecs.accuracy = 0.88;
-    aaSpecs.reloadTime = 4.0;
-    aaSpecs.penetration = 60.0;
-    aaSpecs.requiresLOS = true;
-    aaSpecs.blastRadius = 8.0;
-    aaSpecs.lockOnTime = 3.0;
-    
-    // Guided missile specs (TOW-type)
-    WeaponSpecs guidedSpecs;
-    guidedSpecs.range = 12.0;
-    guidedSpecs.accuracy = 0.95;
-    guidedSpecs.reloadTime = 5.0;
-    guidedSpecs.penetration = 90.0;
-    guidedSpecs.requiresLOS = true;
-    guidedSpecs.blastRadius = 12.0;
-    guidedSpecs.lockOnTime = 4.0;
-    
-    // Machine gun specs
-    WeaponSpecs mgSpecs;
-    mgSpecs.range = 2.0;
-    mgSpecs.accuracy = 0.8;
-    mgSpecs.reloadTime = 0.5;
-    mgSpecs.penetration = 15.0;
-    mgSpecs.requiresLOS = true;
-    mgSpecs.blastRadius = 0.0;
-    mgSpecs.lockOnTime = 0.0;
-    
-    // Add weapons to helicopter
-    weapons.emplace_back("M230 Chain Gun", WeaponType::CANNON, 15, 25, 1200, chainGunSpecs);
-    weapons.emplace_back("Hellfire Missile", WeaponType::AIR_TO_GROUND_MISSILE, 80, 120, 8, missileSpecs);
-    weapons.emplace_back("Hydra 70 Rockets", WeaponType::ROCKET_POD, 35, 55, 38, rocketSpecs);
-    weapons.emplace_back("AIM-9 Sidewinder", WeaponType::AIR_TO_AIR_MISSILE, 55, 85, 4, aaSpecs);
-    weapons.emplace_back("TOW Missile", WeaponType::GUIDED_MISSILE, 90, 130, 6, guidedSpecs);
-    weapons.emplace_back("M134 Minigun", WeaponType::MACHINE_GUN, 8, 15, 2000, mgSpecs);
+    // Add default weapon loadout for combat helicopter, specs come from the archetype table
+    weapons.emplace_back(WeaponType::CANNON);
+    weapons.emplace_back(WeaponType::AIR_TO_GROUND_MISSILE);
+    weapons.emplace_back(WeaponType::ROCKET_POD);
+    weapons.emplace_back(WeaponType::AIR_TO_AIR_MISSILE);
+    weapons.emplace_back(WeaponType::GUIDED_MISSILE);
+    weapons.emplace_back(WeaponType::MACHINE_GUN);
     
     // Removed automatic weapon display - let user choose when to see weapons
 }
@@ -3,7 +3,7 @@
 #include <vector>
 #include <map>
 #include "Weapon.h"
-#include "Enemy.h"
+#include "EnemyStore.h"
 
 enum class WeatherCondition {
     CLEAR,
@@ -21,6 +21,10 @@ enum class TerrainType {
     COASTAL
 };
 
+struct HelicopterSnapshot;
+struct WorldSnapshot;
+class SpatialGrid;
+
 struct Position {
     double x, y, altitude;
     Position(double x = 0, double y = 0, double alt = 100) : x(x), y(y), altitude(alt) {}
@@ -54,9 +58,9 @@ public:
     Helicopter();
     
     // Combat methods
-    void attack(Enemy& target);
-    void attackRandomEnemy(std::vector<Enemy>& enemies);
-    bool attackWithWeapon(Enemy& target, int weaponIndex, double distance);
+    void attack(Enemy target, const RandomService& random);
+    void attackRandomEnemy(EnemyStore& enemies, const RandomService& random);
+    bool attackWithWeapon(Enemy target, int weaponIndex, double distance, const RandomService& random);
     void takeDamage(int damage, const std::string& component = "hull");
     bool isAlive() const;
     bool canFly() const;
@@ -74,11 +78,16 @@ public:
     void emergency_landing();
     double calculateFuelConsumption(double deltaTime) const;
     void refuel();
+    double getFuelFlowRate() const;          // liters per second at current speed and engine health
+    double getTimeToDestination() const;     // seconds, -1 if not moving towards a destination
     
     // Detection and radar
-    double detectEnemy(const Enemy& enemy, WeatherCondition weather) const;
-    bool isDetectedBy(const Enemy& enemy, double distance) const;
-    void performRadarSweep(const std::vector<Enemy>& enemies, WeatherCondition weather) const;
+    double detectEnemy(const EnemyView& enemy, WeatherCondition weather) const;
+    bool isDetectedBy(const EnemyView& enemy, double distance) const;
+    void performRadarSweep(const EnemyStore& enemies, const SpatialGrid& grid, WeatherCondition weather) const;
+    static void showRadarSweep(const WorldSnapshot& snapshot);
+    static double calculateDetection(double distance, double radarRange, double radarHealth,
+                                     WeatherCondition weather, bool airborneTarget);
     
     // Status and diagnostics
     void showStatus() const;
@@ -86,6 +95,7 @@ public:
     void showSystemsStatus() const;
     void performSystemCheck() const;
     void showTacticalAdvice() const;
+    void fillSnapshot(HelicopterSnapshot& snapshot) const;
     
     // Tactical operations
     void performEvasiveManeuvers();
@@ -98,10 +108,13 @@ public:
     
     // Getters
     const Position& getPosition() const { return position; }
+    const Position& getDestination() const { return destination; }
+    bool isHoveringInPlace() const { return isHovering; }
     const FlightParams& getFlightParams() const { return flightParams; }
     const HelicopterSystems& getSystems() const { return systems; }
     double getHealth() const { return health; }
-    std::string getName() const { return name; }
+    const std::vector<Weapon>& getWeapons() const { return weapons; }
+    const std::string& getName() const { return name; }
     
     // Setters for movement
     void setPosition(const Position& newPos) { position = newPos; }
@@ -141,6 +154,6 @@ private:
     // Private helper methods
     void updateFuel(double deltaTime);
     void updateSystems();
-    double calculateWeatherEffect(WeatherCondition weather) const;
+    static double calculateWeatherEffect(WeatherCondition weather);
     void damageSystem(const std::string& component, double damage);
 };
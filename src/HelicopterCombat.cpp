@@ -5,10 +5,12 @@ void HelicopterCombat::run() {
     std::cout << "\n=== ADVANCED HELICOPTER COMBAT SIMULATOR ===" << std::endl;
     //std::cout <<        "" << std::endl;
     
+    game.setWorkerThreads(Game::defaultWorkerThreads());
+    
     int choice;
     do {
         showMainMenu();
-        std::cin >> choice;
+        choice = game.readChoice();
         handleUserInput(choice);
     } while (choice != 0);
 }
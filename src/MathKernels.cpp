@@ -0,0 +1,72 @@
+#include "MathKernels.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+// Defined in the MathKernels*.cpp files, nullptr when the build lacks the level
+const MathKernels* mathKernelsScalar();
+const MathKernels* mathKernelsSse42();
+const MathKernels* mathKernelsAvx2();
+const MathKernels* mathKernelsAvx512();
+
+// Whether the CPU, and the OS saving its registers, supports a level
+static bool cpuSupports(SimdLevel level) {
+    if (level == SimdLevel::SCALAR) return true;
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    switch (level) {
+        case SimdLevel::SSE42: return __builtin_cpu_supports("sse4.2");
+        case SimdLevel::AVX2: return __builtin_cpu_supports("avx2");
+        case SimdLevel::AVX512: return __builtin_cpu_supports("avx512f");
+        default: return false;
+    }
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 1);
+    bool sse42 = (info[2] & (1 << 20)) != 0;
+    bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    bool osSavesAvx512 = osSavesAvx && (_xgetbv(0) & 0xE6) == 0xE6;
+    __cpuid(info, 0);
+    int leaves = info[0];
+    bool avx2 = false, avx512 = false;
+    if (leaves >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+        avx512 = (info[1] & (1 << 16)) != 0;
+    }
+    switch (level) {
+        case SimdLevel::SSE42: return sse42;
+        case SimdLevel::AVX2: return avx2 && osSavesAvx;
+        case SimdLevel::AVX512: return avx512 && osSavesAvx512;
+        default: return false;
+    }
+#else
+    return false;
+#endif
+}
+
+const MathKernels* mathKernelsFor(SimdLevel level) {
+    const MathKernels* kernels = nullptr;
+    switch (level) {
+        case SimdLevel::SCALAR: kernels = mathKernelsScalar(); break;
+        case SimdLevel::SSE42: kernels = mathKernelsSse42(); break;
+        case SimdLevel::AVX2: kernels = mathKernelsAvx2(); break;
+        case SimdLevel::AVX512: kernels = mathKernelsAvx512(); break;
+    }
+    return kernels && cpuSupports(level) ? kernels : nullptr;
+}
+
+static const MathKernels& selectMathKernels() {
+    static const SimdLevel widestFirst[] = { SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::SSE42 };
+    for (SimdLevel level : widestFirst) {
+        if (const MathKernels* kernels = mathKernelsFor(level)) return *kernels;
+    }
+    return *mathKernelsScalar();
+}
+
+const MathKernels& mathKernels() {
+    static const MathKernels& kernels = selectMathKernels();
+    return kernels;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+
+// The radar a batch of contacts is checked against
+struct RadarParameters {
+    double x, y;                // km
+    double range;               // km
+    double health;              // 0.0 to 1.0
+    double weatherEffect;       // Helicopter::calculateWeatherEffect
+};
+
+enum class SimdLevel { SCALAR, SSE42, AVX2, AVX512 };
+
+// Batched math over arrays of count elements. Every instruction set runs the
+// same IEEE-754 operations in the same order, so all levels give
+// bit-identical results and a mixed fleet of machines agrees. Outputs may
+// alias inputs of the same index.
+//
+// Builds with HELICOPTER_DETERMINISTIC_MATH only have the scalar level, and
+// it goes through SimMath's float32 functions instead.
+struct MathKernels {
+    const char* name;           // "scalar", "SSE4.2", "AVX2" or "AVX-512"
+    SimdLevel level;
+
+    // sqrt(x * x + y * y), without hypot's overflow guard
+    void (*hypot)(const double* x, const double* y, double* out, size_t count);
+    // Radians in [-pi, pi], within 1e-8 of libm; signed zeros count as +0
+    void (*atan2)(const double* y, const double* x, double* out, size_t count);
+    // Degrees from the x axis, 0-360, as simBearing
+    void (*bearing)(const double* dx, const double* dy, double* out, size_t count);
+    // Within 3e-16 of libm for |radians| < 1e5
+    void (*sincos)(const double* radians, double* sines, double* cosines, size_t count);
+    void (*clamp)(const double* values, double low, double high, double* out, size_t count);
+    // from + (to - from) * t
+    void (*lerp)(const double* from, const double* to, const double* t, double* out, size_t count);
+    // Detection probability (as Helicopter::calculateDetection), range and
+    // bearing of each contact
+    void (*detect)(const RadarParameters& radar, const double* x, const double* y, const unsigned char* airborne,
+                   double* probabilities, double* ranges, double* bearings, size_t count);
+};
+
+// The widest level this build and CPU support, chosen on the first call
+const MathKernels& mathKernels();
+
+// A specific level, nullptr when the build or the CPU lacks it
+const MathKernels* mathKernelsFor(SimdLevel level);
@@ -0,0 +1,51 @@
+#include "MathKernelsImpl.h"
+
+// Built with -mavx2; run only on CPUs that report it
+#if !defined(HELICOPTER_DETERMINISTIC_MATH) && defined(__AVX2__)
+#include <immintrin.h>
+
+namespace {
+
+// Four doubles per step
+struct Avx2Lanes {
+    typedef __m256d Real;
+    typedef __m256d Mask;
+    static const size_t WIDTH = 4;
+    static Real load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, Real v) { _mm256_storeu_pd(p, v); }
+    static Real set(double v) { return _mm256_set1_pd(v); }
+    static Real add(Real a, Real b) { return _mm256_add_pd(a, b); }
+    static Real sub(Real a, Real b) { return _mm256_sub_pd(a, b); }
+    static Real mul(Real a, Real b) { return _mm256_mul_pd(a, b); }
+    static Real div(Real a, Real b) { return _mm256_div_pd(a, b); }
+    static Real sqrt(Real a) { return _mm256_sqrt_pd(a); }
+    static Real min(Real a, Real b) { return _mm256_min_pd(a, b); }
+    static Real max(Real a, Real b) { return _mm256_max_pd(a, b); }
+    static Real neg(Real a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+    static Real abs(Real a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static Real floor(Real a) { return _mm256_floor_pd(a); }
+    static Real round(Real a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Mask greater(Real a, Real b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static Mask both(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+    static Real select(Mask mask, Real a, Real b) { return _mm256_blendv_pd(b, a, mask); }
+    static Mask flags(const unsigned char* p) {
+        int bytes = p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24);
+        __m256i wide = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(bytes));
+        return _mm256_castsi256_pd(_mm256_cmpgt_epi64(wide, _mm256_setzero_si256()));
+    }
+};
+
+}
+
+const MathKernels* mathKernelsAvx2() {
+    static const MathKernels kernels = makeMathKernels<Avx2Lanes>("AVX2", SimdLevel::AVX2);
+    return &kernels;
+}
+
+#else
+
+const MathKernels* mathKernelsAvx2() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include "MathKernelsImpl.h"
+
+// Built with -mavx512f; run only on CPUs that report it
+#if !defined(HELICOPTER_DETERMINISTIC_MATH) && defined(__AVX512F__)
+#include <immintrin.h>
+#include <cstdint>
+
+namespace {
+
+// Eight doubles per step, comparisons into mask registers. The unmasked
+// forms of sqrt, min, max, roundscale and zero-extension merge into an
+// undefined vector, which GCC reports as maybe-uninitialized once inlined;
+// the merge forms below take an explicit source under a full mask instead.
+struct Avx512Lanes {
+    typedef __m512d Real;
+    typedef __mmask8 Mask;
+    static const size_t WIDTH = 8;
+    static const Mask ALL = 0xFF;
+    static Real load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, Real v) { _mm512_storeu_pd(p, v); }
+    static Real set(double v) { return _mm512_set1_pd(v); }
+    static Real add(Real a, Real b) { return _mm512_add_pd(a, b); }
+    static Real sub(Real a, Real b) { return _mm512_sub_pd(a, b); }
+    static Real mul(Real a, Real b) { return _mm512_mul_pd(a, b); }
+    static Real div(Real a, Real b) { return _mm512_div_pd(a, b); }
+    static Real sqrt(Real a) { return _mm512_mask_sqrt_pd(a, ALL, a); }
+    static Real min(Real a, Real b) { return _mm512_mask_min_pd(a, ALL, a, b); }
+    static Real max(Real a, Real b) { return _mm512_mask_max_pd(a, ALL, a, b); }
+    static Real neg(Real a) {
+        // AVX-512F has no floating-point xor
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(INT64_MIN)));
+    }
+    static Real abs(Real a) { return _mm512_abs_pd(a); }
+    static Real floor(Real a) { return _mm512_mask_roundscale_pd(a, ALL, a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+    static Real round(Real a) { return _mm512_mask_roundscale_pd(a, ALL, a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Mask greater(Real a, Real b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static Mask both(Mask a, Mask b) { return static_cast<Mask>(a & b); }
+    static Real select(Mask mask, Real a, Real b) { return _mm512_mask_blend_pd(mask, b, a); }
+    static Mask flags(const unsigned char* p) {
+        __m512i wide = _mm512_maskz_cvtepu8_epi64(ALL, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+        return _mm512_test_epi64_mask(wide, wide);
+    }
+};
+
+}
+
+const MathKernels* mathKernelsAvx512() {
+    static const MathKernels kernels = makeMathKernels<Avx512Lanes>("AVX-512", SimdLevel::AVX512);
+    return &kernels;
+}
+
+#else
+
+const MathKernels* mathKernelsAvx512() {
+    return nullptr;
+}
+
+#endif
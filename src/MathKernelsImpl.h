@@ -0,0 +1,222 @@
+#pragma once
+#include "MathKernels.h"
+#include <cmath>
+
+// Kernel bodies shared by the MathKernels*.cpp files, each of which is built
+// with its own instruction set flags and instantiates them over its Lanes.
+// A Lanes type wraps one register of WIDTH doubles:
+//
+//   Real, Mask                  register and comparison result types
+//   load, store, set            unaligned memory and broadcast
+//   add, sub, mul, div, sqrt    IEEE-754 arithmetic, correctly rounded
+//   min, max                    a < b ? a : b and a > b ? a : b
+//   neg, abs, floor, round      sign flip, magnitude, rounding (to nearest even)
+//   greater, both, select       a > b, mask AND, mask ? a : b
+//   flags                       WIDTH bytes, set where non-zero
+//
+// Everything here is in an anonymous namespace. The files are compiled with
+// wider instruction sets than the rest of the program, and no inline
+// function from them may be left for the linker to pick for other callers.
+namespace {
+
+// One double per step. Also finishes off every other level's arrays, which
+// keeps the last few elements on the same arithmetic.
+struct ScalarLanes {
+    typedef double Real;
+    typedef bool Mask;
+    static const size_t WIDTH = 1;
+    static Real load(const double* p) { return *p; }
+    static void store(double* p, Real v) { *p = v; }
+    static Real set(double v) { return v; }
+    static Real add(Real a, Real b) { return a + b; }
+    static Real sub(Real a, Real b) { return a - b; }
+    static Real mul(Real a, Real b) { return a * b; }
+    static Real div(Real a, Real b) { return a / b; }
+    static Real sqrt(Real a) { return std::sqrt(a); }
+    static Real min(Real a, Real b) { return a < b ? a : b; }
+    static Real max(Real a, Real b) { return a > b ? a : b; }
+    static Real neg(Real a) { return -a; }
+    static Real abs(Real a) { return std::fabs(a); }
+    static Real floor(Real a) { return std::floor(a); }
+    static Real round(Real a) { return std::nearbyint(a); }
+    static Mask greater(Real a, Real b) { return a > b; }
+    static Mask both(Mask a, Mask b) { return a && b; }
+    static Real select(Mask mask, Real a, Real b) { return mask ? a : b; }
+    static Mask flags(const unsigned char* p) { return *p != 0; }
+};
+
+// Runs Kernel::step over count elements, L::WIDTH at a time and the rest one by one
+template <class L, class Kernel, class... Arrays>
+void runLanes(size_t count, Arrays... arrays) {
+    size_t i = 0;
+    for (; i + L::WIDTH <= count; i += L::WIDTH) {
+        Kernel::template step<L>(i, arrays...);
+    }
+    for (; i < count; ++i) {
+        Kernel::template step<ScalarLanes>(i, arrays...);
+    }
+}
+
+// atan2 folded into the first octant: t = min/max in [0, 1], reduced to
+// [-tan(pi/8), tan(pi/8)] around pi/4 and fitted with the Cephes polynomial
+template <class L>
+typename L::Real atan2Lanes(typename L::Real y, typename L::Real x) {
+    typedef typename L::Real Real;
+    const Real zero = L::set(0.0);
+    const Real one = L::set(1.0);
+
+    Real ax = L::abs(x);
+    Real ay = L::abs(y);
+    Real t = L::div(L::min(ax, ay), L::max(L::max(ax, ay), L::set(2.2250738585072014e-308)));
+    typename L::Mask upper = L::greater(t, L::set(0.414213562373095));
+    t = L::select(upper, L::div(L::sub(t, one), L::add(t, one)), t);
+    Real z = L::mul(t, t);
+    Real poly = L::add(L::mul(L::set(8.05374449538e-2), z), L::set(-1.38776856032e-1));
+    poly = L::add(L::mul(poly, z), L::set(1.99777106478e-1));
+    poly = L::add(L::mul(poly, z), L::set(-3.33329491539e-1));
+    Real angle = L::add(L::add(L::select(upper, L::set(0.785398163397448310), zero), t), L::mul(L::mul(t, z), poly));
+
+    // Unfold: swap the axes back, then mirror into the right quadrant
+    angle = L::select(L::greater(ay, ax), L::sub(L::set(1.57079632679489662), angle), angle);
+    angle = L::select(L::greater(zero, x), L::sub(L::set(3.14159265358979324), angle), angle);
+    return L::select(L::greater(zero, y), L::neg(angle), angle);
+}
+
+template <class L>
+typename L::Real bearingLanes(typename L::Real dx, typename L::Real dy) {
+    typedef typename L::Real Real;
+    Real bearing = L::mul(atan2Lanes<L>(dy, dx), L::set(57.295779513082321));
+    return L::select(L::greater(L::set(0.0), bearing), L::add(bearing, L::set(360.0)), bearing);
+}
+
+struct HypotKernel {
+    template <class L>
+    static void step(size_t i, const double* x, const double* y, double* out) {
+        typename L::Real a = L::load(x + i);
+        typename L::Real b = L::load(y + i);
+        L::store(out + i, L::sqrt(L::add(L::mul(a, a), L::mul(b, b))));
+    }
+};
+
+struct Atan2Kernel {
+    template <class L>
+    static void step(size_t i, const double* y, const double* x, double* out) {
+        L::store(out + i, atan2Lanes<L>(L::load(y + i), L::load(x + i)));
+    }
+};
+
+struct BearingKernel {
+    template <class L>
+    static void step(size_t i, const double* dx, const double* dy, double* out) {
+        L::store(out + i, bearingLanes<L>(L::load(dx + i), L::load(dy + i)));
+    }
+};
+
+// Reduced by the nearest multiple of pi/2 (pi/2 split in three, fdlibm's
+// constants) and fitted with fdlibm's sine and cosine kernels
+struct SinCosKernel {
+    template <class L>
+    static void step(size_t i, const double* radians, double* sines, double* cosines) {
+        typedef typename L::Real Real;
+        Real x = L::load(radians + i);
+        Real k = L::round(L::mul(x, L::set(6.36619772367581382433e-01)));
+        Real r = L::sub(x, L::mul(k, L::set(1.57079632673412561417e+00)));
+        r = L::sub(r, L::mul(k, L::set(6.07710050630396597660e-11)));
+        r = L::sub(r, L::mul(k, L::set(2.02226624879595063154e-21)));
+
+        Real z = L::mul(r, r);
+        Real s = L::add(L::mul(L::set(1.58969099521155010221e-10), z), L::set(-2.50507602534068634195e-08));
+        s = L::add(L::mul(s, z), L::set(2.75573137070700676789e-06));
+        s = L::add(L::mul(s, z), L::set(-1.98412698298579493134e-04));
+        s = L::add(L::mul(s, z), L::set(8.33333333332248946124e-03));
+        s = L::add(L::mul(s, z), L::set(-1.66666666666666324348e-01));
+        Real sine = L::add(r, L::mul(L::mul(r, z), s));
+        Real c = L::add(L::mul(L::set(-1.13596475577881948265e-11), z), L::set(2.08757232129817482790e-09));
+        c = L::add(L::mul(c, z), L::set(-2.75573143513906633035e-07));
+        c = L::add(L::mul(c, z), L::set(2.48015872894767294178e-05));
+        c = L::add(L::mul(c, z), L::set(-1.38888888888741095749e-03));
+        c = L::add(L::mul(c, z), L::set(4.16666666666666019037e-02));
+        Real cosine = L::add(L::sub(L::set(1.0), L::mul(L::set(0.5), z)), L::mul(L::mul(z, z), c));
+
+        // Quadrant k mod 4 picks and signs the two kernels
+        Real quadrant = L::sub(k, L::mul(L::set(4.0), L::floor(L::mul(k, L::set(0.25)))));
+        typename L::Mask odd = L::greater(L::sub(quadrant, L::mul(L::set(2.0), L::floor(L::mul(quadrant, L::set(0.5))))),
+                                          L::set(0.5));
+        typename L::Mask sineNegative = L::greater(quadrant, L::set(1.5));
+        typename L::Mask cosineNegative = L::both(L::greater(quadrant, L::set(0.5)), L::greater(L::set(2.5), quadrant));
+        Real s0 = L::select(odd, cosine, sine);
+        Real c0 = L::select(odd, sine, cosine);
+        L::store(sines + i, L::select(sineNegative, L::neg(s0), s0));
+        L::store(cosines + i, L::select(cosineNegative, L::neg(c0), c0));
+    }
+};
+
+struct ClampKernel {
+    template <class L>
+    static void step(size_t i, const double* values, double low, double high, double* out) {
+        L::store(out + i, L::min(L::max(L::load(values + i), L::set(low)), L::set(high)));
+    }
+};
+
+struct LerpKernel {
+    template <class L>
+    static void step(size_t i, const double* from, const double* to, const double* t, double* out) {
+        typename L::Real a = L::load(from + i);
+        L::store(out + i, L::add(a, L::mul(L::sub(L::load(to + i), a), L::load(t + i))));
+    }
+};
+
+struct DetectKernel {
+    template <class L>
+    static void step(size_t i, const RadarParameters* radar, const double* x, const double* y,
+                     const unsigned char* airborne, double* probabilities, double* ranges, double* bearings) {
+        typedef typename L::Real Real;
+        Real dx = L::sub(L::load(x + i), L::set(radar->x));
+        Real dy = L::sub(L::load(y + i), L::set(radar->y));
+        Real distance = L::sqrt(L::add(L::mul(dx, dx), L::mul(dy, dy)));
+
+        // In Helicopter::calculateDetection's order so the roundings agree
+        Real range = L::set(radar->range);
+        Real chance = L::select(L::greater(distance, range), L::set(0.0),
+                                L::sub(L::set(1.0), L::div(distance, range)));
+        chance = L::mul(chance, L::set(radar->weatherEffect));
+        chance = L::mul(chance, L::set(radar->health));
+        chance = L::mul(chance, L::select(L::flags(airborne + i), L::set(0.7), L::set(1.0)));
+
+        L::store(probabilities + i, chance);
+        L::store(ranges + i, distance);
+        L::store(bearings + i, bearingLanes<L>(dx, dy));
+    }
+};
+
+template <class L>
+MathKernels makeMathKernels(const char* name, SimdLevel level) {
+    MathKernels kernels;
+    kernels.name = name;
+    kernels.level = level;
+    kernels.hypot = [](const double* x, const double* y, double* out, size_t count) {
+        runLanes<L, HypotKernel>(count, x, y, out);
+    };
+    kernels.atan2 = [](const double* y, const double* x, double* out, size_t count) {
+        runLanes<L, Atan2Kernel>(count, y, x, out);
+    };
+    kernels.bearing = [](const double* dx, const double* dy, double* out, size_t count) {
+        runLanes<L, BearingKernel>(count, dx, dy, out);
+    };
+    kernels.sincos = [](const double* radians, double* sines, double* cosines, size_t count) {
+        runLanes<L, SinCosKernel>(count, radians, sines, cosines);
+    };
+    kernels.clamp = [](const double* values, double low, double high, double* out, size_t count) {
+        runLanes<L, ClampKernel>(count, values, low, high, out);
+    };
+    kernels.lerp = [](const double* from, const double* to, const double* t, double* out, size_t count) {
+        runLanes<L, LerpKernel>(count, from, to, t, out);
+    };
+    kernels.detect = [](const RadarParameters& radar, const double* x, const double* y, const unsigned char* airborne,
+                        double* probabilities, double* ranges, double* bearings, size_t count) {
+        runLanes<L, DetectKernel>(count, &radar, x, y, airborne, probabilities, ranges, bearings);
+    };
+    return kernels;
+}
+
+}
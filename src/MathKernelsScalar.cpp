@@ -0,0 +1,74 @@
+#include "MathKernelsImpl.h"
+#include "SimMath.h"
+
+#ifdef HELICOPTER_DETERMINISTIC_MATH
+
+// One element at a time through SimMath, so the float32 builds stay
+// bit-identical everywhere
+static void hypotSim(const double* x, const double* y, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = simDistance(x[i], y[i]);
+}
+
+static void atan2Sim(const double* y, const double* x, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = simAtan2(y[i], x[i]);
+}
+
+static void bearingSim(const double* dx, const double* dy, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = simBearing(dx[i], dy[i]);
+}
+
+static void sincosSim(const double* radians, double* sines, double* cosines, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        double x = radians[i];
+        sines[i] = simSin(x);
+        cosines[i] = simCos(x);
+    }
+}
+
+static void clampSim(const double* values, double low, double high, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        SimReal v = static_cast<SimReal>(values[i]);
+        out[i] = v < low ? low : (v > high ? high : v);
+    }
+}
+
+static void lerpSim(const double* from, const double* to, const double* t, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        SimReal a = static_cast<SimReal>(from[i]);
+        out[i] = a + (static_cast<SimReal>(to[i]) - a) * static_cast<SimReal>(t[i]);
+    }
+}
+
+static void detectSim(const RadarParameters& radar, const double* x, const double* y, const unsigned char* airborne,
+                      double* probabilities, double* ranges, double* bearings, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        double dx = x[i] - radar.x;
+        double dy = y[i] - radar.y;
+        double distance = simDistance(dx, dy);
+
+        // Same steps as Helicopter::calculateDetection
+        SimReal chance = distance > radar.range ? SimReal(0) : SimReal(1) - static_cast<SimReal>(distance / radar.range);
+        chance *= static_cast<SimReal>(radar.weatherEffect);
+        chance *= static_cast<SimReal>(radar.health);
+        if (airborne[i]) chance *= SimReal(0.7);
+
+        probabilities[i] = chance;
+        ranges[i] = distance;
+        bearings[i] = simBearing(dx, dy);
+    }
+}
+
+const MathKernels* mathKernelsScalar() {
+    static const MathKernels kernels = { "scalar", SimdLevel::SCALAR, hypotSim, atan2Sim, bearingSim,
+                                         sincosSim, clampSim, lerpSim, detectSim };
+    return &kernels;
+}
+
+#else
+
+const MathKernels* mathKernelsScalar() {
+    static const MathKernels kernels = makeMathKernels<ScalarLanes>("scalar", SimdLevel::SCALAR);
+    return &kernels;
+}
+
+#endif
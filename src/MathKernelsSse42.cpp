@@ -0,0 +1,50 @@
+#include "MathKernelsImpl.h"
+
+// Built with -msse4.2; run only on CPUs that report it
+#if !defined(HELICOPTER_DETERMINISTIC_MATH) && (defined(__SSE4_2__) || (defined(_MSC_VER) && defined(_M_X64)))
+#include <nmmintrin.h>
+
+namespace {
+
+// Two doubles per step
+struct Sse42Lanes {
+    typedef __m128d Real;
+    typedef __m128d Mask;
+    static const size_t WIDTH = 2;
+    static Real load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, Real v) { _mm_storeu_pd(p, v); }
+    static Real set(double v) { return _mm_set1_pd(v); }
+    static Real add(Real a, Real b) { return _mm_add_pd(a, b); }
+    static Real sub(Real a, Real b) { return _mm_sub_pd(a, b); }
+    static Real mul(Real a, Real b) { return _mm_mul_pd(a, b); }
+    static Real div(Real a, Real b) { return _mm_div_pd(a, b); }
+    static Real sqrt(Real a) { return _mm_sqrt_pd(a); }
+    static Real min(Real a, Real b) { return _mm_min_pd(a, b); }
+    static Real max(Real a, Real b) { return _mm_max_pd(a, b); }
+    static Real neg(Real a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+    static Real abs(Real a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static Real floor(Real a) { return _mm_floor_pd(a); }
+    static Real round(Real a) { return _mm_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Mask greater(Real a, Real b) { return _mm_cmpgt_pd(a, b); }
+    static Mask both(Mask a, Mask b) { return _mm_and_pd(a, b); }
+    static Real select(Mask mask, Real a, Real b) { return _mm_blendv_pd(b, a, mask); }
+    static Mask flags(const unsigned char* p) {
+        __m128i wide = _mm_cvtepu8_epi64(_mm_cvtsi32_si128(p[0] | (p[1] << 8)));
+        return _mm_castsi128_pd(_mm_cmpgt_epi64(wide, _mm_setzero_si128()));
+    }
+};
+
+}
+
+const MathKernels* mathKernelsSse42() {
+    static const MathKernels kernels = makeMathKernels<Sse42Lanes>("SSE4.2", SimdLevel::SSE42);
+    return &kernels;
+}
+
+#else
+
+const MathKernels* mathKernelsSse42() {
+    return nullptr;
+}
+
+#endif
@@ -1,12 +1,15 @@
 #include "Mission.h"
+#include "Snapshot.h"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
 #include <algorithm>
 
-Mission::Mission(MissionType type, const std::string& name, const std::string& briefing)
-    : missionType(type), status(MissionStatus::NOT_STARTED), missionName(name), 
-      briefing(briefing), startTime(0.0), elapsedTime(0.0), enemiesDestroyed(0),
+Mission::Mission(MissionType type, const std::string& name, const std::string& briefing,
+                 std::pmr::memory_resource* memory)
+    : missionType(type), status(MissionStatus::NOT_STARTED), missionName(name, memory), 
+      briefing(briefing, memory), parameters(memory), zones(memory), objectives(memory),
+      startTime(0.0), elapsedTime(0.0), threats(memory), enemiesDestroyed(0),
       damageTaken(0), stealthMaintained(true), accuracyRating(1.0) {
     
     generateObjectives();
@@ -77,7 +80,7 @@ void Mission::start() {
 void Mission::update(double deltaTime) {
     if (status != MissionStatus::IN_PROGRESS) return;
     
-    elapsedTime += deltaTime;
+    elapsedTime += deltaTime / 60.0; // deltaTime is in seconds, mission clock runs in minutes
     updateProgress(deltaTime);
     
     // Check failure conditions
@@ -181,10 +184,16 @@ double Mission::getTimeRemaining() const {
 }
 
 void Mission::showMissionStatus() const {
+    MissionSnapshot snapshot;
+    fillSnapshot(snapshot);
+    showMissionStatus(snapshot);
+}
+
+void Mission::showMissionStatus(const MissionSnapshot& snapshot) {
     std::cout << "\n=== MISSION STATUS ===" << std::endl;
-    std::cout << "Mission: " << missionName << std::endl;
+    std::cout << "Mission: " << snapshot.name << std::endl;
     std::cout << "Status: ";
-    switch (status) {
+    switch (snapshot.status) {
         case MissionStatus::NOT_STARTED: std::cout << "NOT STARTED"; break;
         case MissionStatus::IN_PROGRESS: std::cout << "IN PROGRESS"; break;
         case MissionStatus::COMPLETED: std::cout << "COMPLETED"; break;
@@ -194,24 +203,34 @@ void Mission::showMissionStatus() const {
     std::cout << std::endl;
     
     std::cout << "Progress: " << std::fixed << std::setprecision(1) 
-              << getProgress() * 100 << "%" << std::endl;
+              << snapshot.progress * 100 << "%" << std::endl;
     
-    if (parameters.timeLimit > 0) {
+    if (snapshot.timeLimit > 0) {
         std::cout << "Time remaining: " << std::fixed << std::setprecision(1) 
-                  << getTimeRemaining() << " minutes" << std::endl;
+                  << snapshot.timeRemaining << " minutes" << std::endl;
     }
     
     std::cout << "\nObjectives:" << std::endl;
-    for (size_t i = 0; i < objectives.size(); ++i) {
-        std::cout << "  " << (objectives[i].completed ? "[X]" : "[ ]") 
-                  << " " << objectives[i].description;
-        if (objectives[i].critical) {
+    for (const auto& objective : snapshot.objectives) {
+        std::cout << "  " << (objective.completed ? "[X]" : "[ ]") 
+                  << " " << objective.description;
+        if (objective.critical) {
             std::cout << " (CRITICAL)";
         }
         std::cout << std::endl;
     }
 }
 
+void Mission::fillSnapshot(MissionSnapshot& snapshot) const {
+    snapshot.active = true;
+    snapshot.name.assign(missionName.data(), missionName.size());
+    snapshot.status = status;
+    snapshot.progress = getProgress();
+    snapshot.timeLimit = parameters.timeLimit;
+    snapshot.timeRemaining = getTimeRemaining();
+    snapshot.objectives.assign(objectives.begin(), objectives.end());
+}
+
 void Mission::showDetailedBriefing() const {
     std::cout << "\n=== MISSION BRIEFING ===" << std::endl;
     std::cout << "Operation: " << missionName << std::endl;
@@ -312,38 +331,37 @@ std::string Mission::getMissionRating() const {
     else return "FAILURE";
 }
 
-void Mission::addThreat(const Enemy& enemy) {
-    threats.push_back(enemy);
+void Mission::addThreat(const EnemyView& enemy) {
+    threats.add(enemy);
 }
 
 void Mission::removeThreat(size_t index) {
     if (index < threats.size()) {
-        threats.erase(threats.begin() + index);
+        threats.erase(index);
     }
 }
 
-bool Mission::isInNoFlyZone(const Position& pos) const {
-    for (const auto& zone : parameters.noFlyZones) {
-        double distance = calculateDistance(pos, zone);
-        if (distance < 2.0) { // 2km no-fly radius
-            return true;
-        }
+void Mission::setParameters(const MissionParameters& params) {
+    parameters = params;
+    
+    zones.clear();
+    for (const MissionZone& zone : parameters.noFlyZones) {
+        zones.add(Zone(zone.center.x, zone.center.y, zone.radius, ZONE_NO_FLY));
     }
-    return false;
+    for (const MissionZone& zone : parameters.threatAreas) {
+        zones.add(Zone(zone.center.x, zone.center.y, zone.radius, ZONE_THREAT));
+    }
+    zones.build();
+}
+
+bool Mission::isInNoFlyZone(const Position& pos) const {
+    return zones.contains(pos.x, pos.y, ZONE_NO_FLY);
 }
 
 bool Mission::isInThreatArea(const Position& pos) const {
-    for (const auto& threat : parameters.threatAreas) {
-        double distance = calculateDistance(pos, threat);
-        if (distance < 5.0) { // 5km threat radius
-            return true;
-        }
-    }
-    return false;
+    return zones.contains(pos.x, pos.y, ZONE_THREAT);
 }
 
-double Mission::calculateDistance(const Position& pos1, const EnemyPosition& pos2) const {
-    double dx = pos1.x - pos2.x;
-    double dy = pos1.y - pos2.y;
-    return sqrt(dx*dx + dy*dy);
+bool Mission::routeCrossesNoFlyZone(const Position& from, const Position& to) const {
+    return zones.crosses(from.x, from.y, to.x, to.y, ZONE_NO_FLY);
 }
@@ -2,8 +2,10 @@
 #include <string>
 #include <vector>
 #include <map>
-#include "Enemy.h"
+#include <memory_resource>
+#include "EnemyStore.h"
 #include "Helicopter.h"
+#include "ZoneIndex.h"
 
 enum class MissionType {
     SEARCH_AND_DESTROY,
@@ -23,30 +25,57 @@ enum class MissionStatus {
     ABORTED
 };
 
+struct MissionSnapshot;
+
+// Objectives and parameters take the allocator of the container holding
+// them, so a mission's copies live in its arena
 struct Objective {
-    std::string description;
+    typedef std::pmr::polymorphic_allocator<char> allocator_type;
+    
+    std::pmr::string description;
     bool completed;
     bool critical;          // Mission fails if critical objective fails
     int priority;           // 1-10, higher = more important
     
-    Objective(const std::string& desc, bool crit = false, int prio = 5) 
-        : description(desc), completed(false), critical(crit), priority(prio) {}
+    Objective(const std::string& desc, bool crit = false, int prio = 5,
+              const allocator_type& alloc = allocator_type())
+        : description(desc, alloc), completed(false), critical(crit), priority(prio) {}
+    Objective(const Objective& other, const allocator_type& alloc)
+        : description(other.description, alloc), completed(other.completed),
+          critical(other.critical), priority(other.priority) {}
+    Objective(const Objective& other) = default;
+    Objective& operator=(const Objective& other) = default;
+};
+
+// A circular area of the mission map
+struct MissionZone {
+    EnemyPosition center;
+    double radius;                  // km
+    
+    MissionZone(const EnemyPosition& center, double radius) : center(center), radius(radius) {}
 };
 
 struct MissionParameters {
-    std::string area;               // e.g., "Desert Valley", "Urban Zone Alpha"
+    std::pmr::string area;          // e.g., "Desert Valley", "Urban Zone Alpha"
     TerrainType terrain;
     WeatherCondition weather;
     double timeLimit;               // minutes, -1 for no limit
     double allowedCasualties;       // percentage
     bool stealthRequired;
-    std::vector<EnemyPosition> threatAreas;
-    std::vector<EnemyPosition> noFlyZones;
+    std::pmr::vector<MissionZone> threatAreas;
+    std::pmr::vector<MissionZone> noFlyZones;
+    
+    explicit MissionParameters(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : area(memory), terrain(TerrainType::DESERT), weather(WeatherCondition::CLEAR),
+          timeLimit(-1.0), allowedCasualties(0.0), stealthRequired(false),
+          threatAreas(memory), noFlyZones(memory) {}
 };
 
 class Mission {
 public:
-    Mission(MissionType type, const std::string& name, const std::string& briefing);
+    // Strings, objectives, parameters and threats draw from memory
+    Mission(MissionType type, const std::string& name, const std::string& briefing,
+            std::pmr::memory_resource* memory = std::pmr::get_default_resource());
     
     // Mission lifecycle
     void start();
@@ -64,45 +93,49 @@ public:
     // Mission information
     MissionType getType() const { return missionType; }
     MissionStatus getStatus() const { return status; }
-    std::string getName() const { return missionName; }
-    std::string getBriefing() const { return briefing; }
+    std::string getName() const { return std::string(missionName); }
+    std::string getBriefing() const { return std::string(briefing); }
     const MissionParameters& getParameters() const { return parameters; }
     
     // Progress tracking
     double getProgress() const;
     double getTimeRemaining() const;
     void showMissionStatus() const;
+    static void showMissionStatus(const MissionSnapshot& snapshot);
+    void fillSnapshot(MissionSnapshot& snapshot) const;
     void showDetailedBriefing() const;
     
     // Enemy and threat management
-    void addThreat(const Enemy& enemy);
+    void addThreat(const EnemyView& enemy);
     void removeThreat(size_t index);
-    const std::vector<Enemy>& getThreats() const { return threats; }
+    const EnemyStore& getThreats() const { return threats; }
     
     // Scoring and evaluation
     int calculateScore() const;
     std::string getMissionRating() const;
     
     // Mission parameters
-    void setParameters(const MissionParameters& params) { parameters = params; }
+    void setParameters(const MissionParameters& params);
     bool isInNoFlyZone(const Position& pos) const;
     bool isInThreatArea(const Position& pos) const;
+    bool routeCrossesNoFlyZone(const Position& from, const Position& to) const;
 
 private:
     // Core mission data
     MissionType missionType;
     MissionStatus status;
-    std::string missionName;
-    std::string briefing;
+    std::pmr::string missionName;
+    std::pmr::string briefing;
     MissionParameters parameters;
+    ZoneIndex zones;
     
     // Objectives and progress
-    std::vector<Objective> objectives;
+    std::pmr::vector<Objective> objectives;
     double startTime;
     double elapsedTime;
     
     // Threats and enemies
-    std::vector<Enemy> threats;
+    EnemyStore threats;
     
     // Performance metrics
     int enemiesDestroyed;
@@ -114,5 +147,4 @@ private:
     void generateObjectives();
     void updateProgress(double deltaTime);
     bool checkFailureConditions() const;
-    double calculateDistance(const Position& pos1, const EnemyPosition& pos2) const;
 };
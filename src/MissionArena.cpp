@@ -0,0 +1,27 @@
+#include "MissionArena.h"
+
+MissionArena::MissionArena(size_t initialSize)
+    : initialBuffer(new unsigned char[initialSize]), arena(initialBuffer.get(), initialSize),
+      bytesAllocated(0), allocationCount(0), releaseCount(0) {}
+
+void MissionArena::release() {
+    arena.release();
+    bytesAllocated = 0;
+    allocationCount = 0;
+    ++releaseCount;
+}
+
+void* MissionArena::do_allocate(size_t bytes, size_t alignment) {
+    bytesAllocated += bytes;
+    ++allocationCount;
+    return arena.allocate(bytes, alignment);
+}
+
+void MissionArena::do_deallocate(void* pointer, size_t bytes, size_t alignment) {
+    // Monotonic - memory only comes back on release()
+    arena.deallocate(pointer, bytes, alignment);
+}
+
+bool MissionArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
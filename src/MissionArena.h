@@ -0,0 +1,49 @@
+#pragma once
+#include <memory_resource>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstddef>
+
+// Destroys an object placed in an arena; its memory goes back with the arena
+template <typename T>
+struct ArenaDelete {
+    void operator()(T* object) const { object->~T(); }
+};
+
+template <typename T>
+using ArenaPtr = std::unique_ptr<T, ArenaDelete<T>>;
+
+// Monotonic memory for everything that lives exactly as long as one mission:
+// the Mission itself, its objectives, parameters and threat list. Nothing is
+// freed individually; release() drops the lot when the next mission starts.
+class MissionArena : public std::pmr::memory_resource {
+public:
+    explicit MissionArena(size_t initialSize = 16 * 1024);
+    MissionArena(const MissionArena&) = delete;
+    MissionArena& operator=(const MissionArena&) = delete;
+    
+    template <typename T, typename... Args>
+    ArenaPtr<T> create(Args&&... args) {
+        void* memory = allocate(sizeof(T), alignof(T));
+        return ArenaPtr<T>(new (memory) T(std::forward<Args>(args)...));
+    }
+    
+    // Every object created from the arena must be gone first
+    void release();
+    
+    size_t getBytesAllocated() const { return bytesAllocated; }
+    size_t getAllocationCount() const { return allocationCount; }
+    size_t getReleaseCount() const { return releaseCount; }
+
+private:
+    std::unique_ptr<unsigned char[]> initialBuffer;   // reused by every mission
+    std::pmr::monotonic_buffer_resource arena;        // overflow comes from the heap
+    size_t bytesAllocated;      // since the last release
+    size_t allocationCount;
+    size_t releaseCount;
+    
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
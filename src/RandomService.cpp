@@ -0,0 +1,59 @@
+#include "RandomService.h"
+
+// Philox4x32 constants (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+static const uint32_t PHILOX_M0 = 0xD2511F53u;
+static const uint32_t PHILOX_M1 = 0xCD9E8D57u;
+static const uint32_t PHILOX_W0 = 0x9E3779B9u;
+static const uint32_t PHILOX_W1 = 0xBB67AE85u;
+static const int PHILOX_ROUNDS = 10;
+
+RandomService::RandomService(uint64_t seed) : seed(seed), currentTick(0), currentAction(0) {}
+
+RandomKey RandomService::key(EntityId entity, RandomPurpose purpose, uint32_t draw) const {
+    // Actions get the low 16 bits so every tick has room for plenty of them
+    return RandomKey(entity, (currentTick << 16) | (currentAction & 0xFFFFu), purpose, draw);
+}
+
+uint64_t RandomService::bits(const RandomKey& key) const {
+    uint32_t counter[4] = {
+        key.entity,
+        static_cast<uint32_t>(key.counter),
+        static_cast<uint32_t>(key.counter >> 32),
+        (static_cast<uint32_t>(key.purpose) << 24) | (key.draw & 0xFFFFFFu)
+    };
+    uint32_t k0 = static_cast<uint32_t>(seed);
+    uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+    
+    for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+        uint64_t product0 = static_cast<uint64_t>(PHILOX_M0) * counter[0];
+        uint64_t product1 = static_cast<uint64_t>(PHILOX_M1) * counter[2];
+        uint32_t next0 = static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ k0;
+        uint32_t next1 = static_cast<uint32_t>(product1);
+        uint32_t next2 = static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ k1;
+        uint32_t next3 = static_cast<uint32_t>(product0);
+        counter[0] = next0;
+        counter[1] = next1;
+        counter[2] = next2;
+        counter[3] = next3;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    return (static_cast<uint64_t>(counter[0]) << 32) | counter[1];
+}
+
+double RandomService::uniform(const RandomKey& key) const {
+    // Top 53 bits fill the double mantissa exactly
+    return static_cast<double>(bits(key) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double RandomService::uniformReal(double min, double max, const RandomKey& key) const {
+    return min + (max - min) * uniform(key);
+}
+
+int RandomService::uniformInt(int min, int max, const RandomKey& key) const {
+    if (max <= min) return min;
+    // Multiply-shift maps 32 random bits onto the range without division
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    uint64_t scaled = (static_cast<uint64_t>(static_cast<uint32_t>(bits(key) >> 32)) * range) >> 32;
+    return static_cast<int>(min + static_cast<int64_t>(scaled));
+}
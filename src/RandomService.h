@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+
+typedef uint32_t EntityId;
+const EntityId WORLD_ENTITY = 0;        // environment and other global draws
+const EntityId PLAYER_ENTITY = 1;       // the helicopter and its weapons
+const EntityId FIRST_ENEMY_ENTITY = 2;
+
+// What a draw is for - part of the key so unrelated draws never collide
+enum class RandomPurpose : uint32_t {
+    ENEMY_DAMAGE,
+    ENEMY_DETECTION,
+    WEAPON_HIT,
+    WEAPON_DAMAGE,
+    TARGET_SELECTION,
+    WIND_SPEED,
+    WIND_DIRECTION,
+    WEATHER_CHOICE,
+    WEATHER_DURATION
+};
+
+// Identifies one draw. counter is whatever clock the caller advances
+// deterministically: the game tick (see RandomService::key), a gust number...
+struct RandomKey {
+    EntityId entity;
+    uint64_t counter;
+    RandomPurpose purpose;
+    uint32_t draw;              // distinguishes several draws with the same key
+
+    RandomKey(EntityId entity, uint64_t counter, RandomPurpose purpose, uint32_t draw = 0)
+        : entity(entity), counter(counter), purpose(purpose), draw(draw) {}
+};
+
+// Counter-based random numbers (Philox4x32-10). A draw is a pure function of
+// the run seed and its key, so results do not depend on which thread asks or
+// in what order, and entities need no generator state of their own.
+class RandomService {
+public:
+    explicit RandomService(uint64_t seed = 0);
+    
+    void setSeed(uint64_t value) { seed = value; }
+    uint64_t getSeed() const { return seed; }
+    
+    // Game clock for draws keyed by tick. Serial combat actions between two
+    // ticks each call beginAction() so repeated attacks roll differently.
+    void setTick(uint64_t tick) { currentTick = tick; currentAction = 0; }
+    void beginAction() { currentAction++; }
+    RandomKey key(EntityId entity, RandomPurpose purpose, uint32_t draw = 0) const;
+    
+    uint64_t bits(const RandomKey& key) const;
+    double uniform(const RandomKey& key) const;                           // [0, 1)
+    double uniformReal(double min, double max, const RandomKey& key) const;
+    int uniformInt(int min, int max, const RandomKey& key) const;         // inclusive
+
+private:
+    uint64_t seed;
+    uint64_t currentTick;
+    uint32_t currentAction;
+};
@@ -0,0 +1,60 @@
+#include "RelativeGeometry.h"
+#include "MathKernels.h"
+
+RelativeGeometry::RelativeGeometry() : valid(false), revision(0), observer(0, 0, 0), rebuilds(0) {}
+
+void RelativeGeometry::update(const Position& from, const EnemyStore& targets, double time) {
+    if (valid && revision == targets.getRevision() && observer.x == from.x &&
+        observer.y == from.y && observer.altitude == from.altitude) {
+        return;
+    }
+    valid = true;
+    revision = targets.getRevision();
+    observer = from;
+    rebuilds++;
+
+    // Capacity only grows with the population, so steady ticks do not allocate
+    size_t count = targets.size();
+    offsetsX.resize(count);
+    offsetsY.resize(count);
+    ranges.resize(count);
+    bearings.resize(count);
+    altitudeDeltas.resize(count);
+    closureRates.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const EnemyPosition& pos = targets[i].getPosition();
+        offsetsX[i] = pos.x - from.x;
+        offsetsY[i] = pos.y - from.y;
+        altitudeDeltas[i] = pos.altitude - from.altitude;
+    }
+    const MathKernels& math = mathKernels();
+    math.hypot(offsetsX.data(), offsetsY.data(), ranges.data(), count);
+    math.bearing(offsetsX.data(), offsetsY.data(), bearings.data(), count);
+
+    // Closure from the range change since the unit was last seen; a rebuild
+    // at the same time (the observer was moved by hand) keeps the last rate
+    for (size_t i = 0; i < count; ++i) {
+        EnemyHandle handle = targets.getHandle(i);
+        if (handle.slot >= history.size()) {
+            history.resize(handle.slot + 1, RangeSample{ 0, 0.0, 0.0, 0.0 });
+        }
+        RangeSample& sample = history[handle.slot];
+        if (sample.generation != handle.generation) {
+            sample = RangeSample{ handle.generation, ranges[i], time, 0.0 };
+        } else if (time > sample.time) {
+            sample.closureRate = (sample.range - ranges[i]) / (time - sample.time) * 3600.0;
+            sample.range = ranges[i];
+            sample.time = time;
+        }
+        closureRates[i] = sample.closureRate;
+    }
+}
+
+size_t RelativeGeometry::nearest() const {
+    size_t best = 0;
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        if (ranges[i] < ranges[best]) best = i;
+    }
+    return best;
+}
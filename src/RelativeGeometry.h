@@ -0,0 +1,56 @@
+#pragma once
+#include "Helicopter.h"
+#include "EnemyStore.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Range, bearing, altitude difference and closure rate from one observer to
+// every unit of an EnemyStore, indexed like the store. Radar, navigation and
+// combat all read the same table instead of each working out the vectors.
+//
+// update() rebuilds only when the table is stale: after invalidate(), when
+// units are added or removed (the store's revision), or when the observer
+// has moved. Whoever moves units without changing the revision - the tick -
+// must call invalidate().
+class RelativeGeometry {
+public:
+    RelativeGeometry();
+
+    // time is the simulation clock in seconds; closure rates compare each
+    // unit's range with its range at the previous rebuild
+    void update(const Position& observer, const EnemyStore& targets, double time);
+    void invalidate() { valid = false; }
+
+    size_t size() const { return ranges.size(); }
+    double getRange(size_t index) const { return ranges[index]; }           // km
+    double getBearing(size_t index) const { return bearings[index]; }       // degrees, 0-360
+    double getAltitudeDelta(size_t index) const { return altitudeDeltas[index]; }   // target minus observer
+    double getClosureRate(size_t index) const { return closureRates[index]; }       // km/h, > 0 closing
+
+    size_t nearest() const;             // index of the closest unit, 0 when empty
+    long long getRebuilds() const { return rebuilds; }
+
+private:
+    // Per unit, in store order
+    std::vector<double> offsetsX;       // unit minus observer, km
+    std::vector<double> offsetsY;
+    std::vector<double> ranges;
+    std::vector<double> bearings;
+    std::vector<double> altitudeDeltas;
+    std::vector<double> closureRates;
+
+    // Range history by handle slot, which survives reordering and removals
+    struct RangeSample {
+        uint32_t generation;            // 0 until the slot's unit is first seen
+        double range;
+        double time;
+        double closureRate;
+    };
+    std::vector<RangeSample> history;
+
+    bool valid;
+    unsigned long long revision;
+    Position observer;
+    long long rebuilds;
+};
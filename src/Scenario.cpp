@@ -0,0 +1,183 @@
+#include "Scenario.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+static const MissionType allMissionTypes[] = {
+    MissionType::SEARCH_AND_DESTROY, MissionType::RECONNAISSANCE, MissionType::ESCORT,
+    MissionType::RESCUE, MissionType::SUPPLY_DROP, MissionType::GROUND_SUPPORT,
+    MissionType::PATROL
+};
+
+static const WeatherCondition allWeather[] = {
+    WeatherCondition::CLEAR, WeatherCondition::LIGHT_RAIN, WeatherCondition::HEAVY_RAIN,
+    WeatherCondition::FOG, WeatherCondition::SANDSTORM
+};
+
+static const TerrainType allTerrain[] = {
+    TerrainType::DESERT, TerrainType::FOREST, TerrainType::URBAN,
+    TerrainType::MOUNTAIN, TerrainType::COASTAL
+};
+
+const char* missionTypeName(MissionType type) {
+    switch (type) {
+        case MissionType::SEARCH_AND_DESTROY: return "SEARCH_AND_DESTROY";
+        case MissionType::RECONNAISSANCE: return "RECONNAISSANCE";
+        case MissionType::ESCORT: return "ESCORT";
+        case MissionType::RESCUE: return "RESCUE";
+        case MissionType::SUPPLY_DROP: return "SUPPLY_DROP";
+        case MissionType::GROUND_SUPPORT: return "GROUND_SUPPORT";
+        case MissionType::PATROL: return "PATROL";
+        default: return "UNKNOWN";
+    }
+}
+
+const char* missionStatusName(MissionStatus status) {
+    switch (status) {
+        case MissionStatus::NOT_STARTED: return "NOT_STARTED";
+        case MissionStatus::IN_PROGRESS: return "IN_PROGRESS";
+        case MissionStatus::COMPLETED: return "COMPLETED";
+        case MissionStatus::FAILED: return "FAILED";
+        case MissionStatus::ABORTED: return "ABORTED";
+        default: return "UNKNOWN";
+    }
+}
+
+const char* weatherName(WeatherCondition weather) {
+    switch (weather) {
+        case WeatherCondition::CLEAR: return "CLEAR";
+        case WeatherCondition::LIGHT_RAIN: return "LIGHT_RAIN";
+        case WeatherCondition::HEAVY_RAIN: return "HEAVY_RAIN";
+        case WeatherCondition::FOG: return "FOG";
+        case WeatherCondition::SANDSTORM: return "SANDSTORM";
+        default: return "UNKNOWN";
+    }
+}
+
+const char* terrainName(TerrainType terrain) {
+    switch (terrain) {
+        case TerrainType::DESERT: return "DESERT";
+        case TerrainType::FOREST: return "FOREST";
+        case TerrainType::URBAN: return "URBAN";
+        case TerrainType::MOUNTAIN: return "MOUNTAIN";
+        case TerrainType::COASTAL: return "COASTAL";
+        default: return "UNKNOWN";
+    }
+}
+
+bool parseMissionType(const std::string& name, MissionType& type) {
+    for (MissionType candidate : allMissionTypes) {
+        if (name == missionTypeName(candidate)) {
+            type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseWeather(const std::string& name, WeatherCondition& weather) {
+    for (WeatherCondition candidate : allWeather) {
+        if (name == weatherName(candidate)) {
+            weather = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseTerrain(const std::string& name, TerrainType& terrain) {
+    for (TerrainType candidate : allTerrain) {
+        if (name == terrainName(candidate)) {
+            terrain = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+static bool parseNumber(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end != text.c_str() && *end == '\0';
+}
+
+static bool parseBool(const std::string& text, bool& value) {
+    if (text == "true" || text == "1" || text == "yes") { value = true; return true; }
+    if (text == "false" || text == "0" || text == "no") { value = false; return true; }
+    return false;
+}
+
+bool loadScenario(const std::string& path, ScenarioConfig& config, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open scenario file '" + path + "'";
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error = path + ":" + std::to_string(lineNumber) + ": expected 'key = value'";
+            return false;
+        }
+
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+        double number = 0.0;
+        bool ok = true;
+
+        if (key == "mission") {
+            ok = parseMissionType(value, config.missionType);
+        } else if (key == "difficulty") {
+            ok = parseNumber(value, number);
+            config.difficulty = static_cast<int>(number);
+        } else if (key == "time_step") {
+            ok = parseNumber(value, number) && number > 0.0;
+            config.timeStep = number;
+        } else if (key == "max_sim_time") {
+            ok = parseNumber(value, number) && number > 0.0;
+            config.maxSimTime = number;
+        } else if (key == "time_limit") {
+            ok = parseNumber(value, number);
+            config.timeLimit = number;
+        } else if (key == "weather") {
+            ok = parseWeather(value, config.weather);
+        } else if (key == "terrain") {
+            ok = parseTerrain(value, config.terrain);
+        } else if (key == "dynamic_weather") {
+            ok = parseBool(value, config.dynamicWeather);
+        } else if (key == "cruise_speed") {
+            ok = parseNumber(value, number) && number > 0.0;
+            config.cruiseSpeed = number;
+        } else if (key == "engagement_interval") {
+            ok = parseNumber(value, number) && number >= 0.0;
+            config.engagementInterval = number;
+        } else {
+            error = path + ":" + std::to_string(lineNumber) + ": unknown key '" + key + "'";
+            return false;
+        }
+
+        if (!ok) {
+            error = path + ":" + std::to_string(lineNumber) + ": invalid value '" + value
+                    + "' for '" + key + "'";
+            return false;
+        }
+    }
+
+    return true;
+}
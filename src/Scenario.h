@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+#include "Mission.h"
+
+// Scenario description used by headless batch runs
+struct ScenarioConfig {
+    MissionType missionType;
+    int difficulty;
+    double timeStep;            // seconds of simulated time per tick
+    double maxSimTime;          // seconds, hard stop for a single run
+    double timeLimit;           // minutes, mission time limit
+    WeatherCondition weather;
+    TerrainType terrain;
+    bool dynamicWeather;
+    double cruiseSpeed;         // km/h used by the autopilot while transiting
+    double engagementInterval;  // seconds between autopilot attacks
+
+    ScenarioConfig()
+        : missionType(MissionType::SEARCH_AND_DESTROY), difficulty(5), timeStep(0.1),
+          maxSimTime(3600.0), timeLimit(45.0), weather(WeatherCondition::CLEAR),
+          terrain(TerrainType::DESERT), dynamicWeather(true), cruiseSpeed(150.0),
+          engagementInterval(5.0) {}
+};
+
+// Reads "key = value" lines ('#' starts a comment). Returns false and fills
+// error on unreadable files, unknown keys or malformed values.
+bool loadScenario(const std::string& path, ScenarioConfig& config, std::string& error);
+
+// Enum <-> name helpers shared by the scenario parser and result writers
+const char* missionTypeName(MissionType type);
+const char* missionStatusName(MissionStatus status);
+const char* weatherName(WeatherCondition weather);
+const char* terrainName(TerrainType terrain);
+bool parseMissionType(const std::string& name, MissionType& type);
+bool parseWeather(const std::string& name, WeatherCondition& weather);
+bool parseTerrain(const std::string& name, TerrainType& terrain);
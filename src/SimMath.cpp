@@ -0,0 +1,97 @@
+#include "SimMath.h"
+
+#ifdef HELICOPTER_DETERMINISTIC_MATH
+
+// float32 sine, cosine and arctangent built only from IEEE-754 basic
+// operations, which round the same everywhere. Polynomials are the Cephes
+// single-precision minimax fits, within 3 ulp of the exact result.
+
+// pi/2 split so k * PIO2_1 and k * PIO2_2 are exact for the k we see
+static const float PIO2_1 = 1.5703125f;
+static const float PIO2_2 = 4.837512969970703125e-4f;
+static const float PIO2_3 = 7.54978995489188216e-8f;
+static const float TWO_OVER_PI = 0.636619772367581343f;
+static const float PI_F = 3.14159265358979323846f;
+static const float PIO2_F = 1.57079632679489662f;
+static const float PIO4_F = 0.785398163397448310f;
+
+// sin and cos of r in [-pi/4, pi/4]
+static float sinKernel(float r) {
+    float z = r * r;
+    return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+}
+
+static float cosKernel(float r) {
+    float z = r * r;
+    return 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+}
+
+// sin(x + quadrant * pi/2)
+static float sinQuadrant(float x, int quadrant) {
+    float k = std::floor(x * TWO_OVER_PI + 0.5f);
+    float r = ((x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3;
+    switch ((static_cast<int>(k) + quadrant) & 3) {
+        case 0: return sinKernel(r);
+        case 1: return cosKernel(r);
+        case 2: return -sinKernel(r);
+        default: return -cosKernel(r);
+    }
+}
+
+// atan of a in [0, 1]
+static float atanUnit(float a) {
+    float offset = 0.0f;
+    if (a > 0.414213562373095f) {
+        offset = PIO4_F;
+        a = (a - 1.0f) / (a + 1.0f);
+    }
+    float z = a * a;
+    return offset + a + a * z * (-3.33329491539e-1f + z * (1.99777106478e-1f + z * (-1.38776856032e-1f + z * 8.05374449538e-2f)));
+}
+
+double simSin(double radians) {
+    return sinQuadrant(static_cast<float>(radians), 0);
+}
+
+double simCos(double radians) {
+    return sinQuadrant(static_cast<float>(radians), 1);
+}
+
+double simAtan2(double y, double x) {
+    float fy = static_cast<float>(y);
+    float fx = static_cast<float>(x);
+    float ay = std::fabs(fy);
+    float ax = std::fabs(fx);
+    if (ax == 0.0f && ay == 0.0f) return 0.0;
+
+    // Fold into the first octant and unfold the angle
+    float angle = ay > ax ? PIO2_F - atanUnit(ax / ay) : atanUnit(ay / ax);
+    if (fx < 0.0f) angle = PI_F - angle;
+    return fy < 0.0f ? -angle : angle;
+}
+
+double simBearing(double dx, double dy) {
+    float bearing = static_cast<float>(simAtan2(dy, dx)) * static_cast<float>(SIM_DEGREES_PER_RADIAN);
+    return bearing < 0.0f ? bearing + 360.0f : bearing;
+}
+
+#else
+
+double simSin(double radians) {
+    return std::sin(radians);
+}
+
+double simCos(double radians) {
+    return std::cos(radians);
+}
+
+double simAtan2(double y, double x) {
+    return std::atan2(y, x);
+}
+
+double simBearing(double dx, double dy) {
+    double bearing = std::atan2(dy, dx) * SIM_DEGREES_PER_RADIAN;
+    return bearing < 0.0 ? bearing + 360.0 : bearing;
+}
+
+#endif
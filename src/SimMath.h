@@ -0,0 +1,42 @@
+#pragma once
+#include <cmath>
+
+// Math for the simulation: kinematics, distances, bearings and hit and
+// detection odds. Builds with HELICOPTER_DETERMINISTIC_MATH (the CMake
+// option DETERMINISTIC_MATH) evaluate it in float32 and use the
+// transcendentals below instead of libm, so a run gives bit-identical results
+// with any compiler on any IEEE-754 machine. Otherwise SimReal is double and
+// the functions forward to <cmath>.
+#ifdef HELICOPTER_DETERMINISTIC_MATH
+typedef float SimReal;
+#else
+typedef double SimReal;
+#endif
+
+const double SIM_PI = 3.14159265358979323846;
+const double SIM_DEGREES_PER_RADIAN = 180.0 / SIM_PI;
+
+// sqrt is correctly rounded by IEEE-754, so float32 needs no replacement
+inline double simSqrt(double value) {
+    return std::sqrt(static_cast<SimReal>(value));
+}
+
+inline double simDistance(double dx, double dy) {
+    SimReal x = static_cast<SimReal>(dx);
+    SimReal y = static_cast<SimReal>(dy);
+    return std::sqrt(x * x + y * y);
+}
+
+inline double simDistance(double dx, double dy, double dz) {
+    SimReal x = static_cast<SimReal>(dx);
+    SimReal y = static_cast<SimReal>(dy);
+    SimReal z = static_cast<SimReal>(dz);
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+double simSin(double radians);
+double simCos(double radians);
+double simAtan2(double y, double x);
+
+// Angle of (dx, dy) from the x axis in degrees, 0-360
+double simBearing(double dx, double dy);
@@ -0,0 +1,56 @@
+#include "SimulationClock.h"
+#include <algorithm>
+
+SimulationClock::SimulationClock(double stepSize, double cpuBudgetMs)
+    : stepSize(stepSize), cpuBudgetMs(cpuBudgetMs), maxBacklog(60.0), accumulator(0.0),
+      droppedTime(0.0), frameSteps(0), totalSteps(0), budgetExceeded(false) {
+}
+
+void SimulationClock::beginFrame(double simSeconds) {
+    frameStart = std::chrono::steady_clock::now();
+    frameSteps = 0;
+    budgetExceeded = false;
+    
+    accumulator += std::max(0.0, simSeconds);
+    
+    // Never let the backlog grow without bound (spiral of death); the excess
+    // is discarded so the simulation runs slower than requested instead.
+    if (accumulator > maxBacklog) {
+        droppedTime += accumulator - maxBacklog;
+        accumulator = maxBacklog;
+    }
+}
+
+bool SimulationClock::nextStep() {
+    if (accumulator < stepSize) return false;
+    
+    // Always allow one step per frame so the simulation makes progress
+    if (frameSteps > 0) {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - frameStart;
+        if (elapsed.count() >= cpuBudgetMs) {
+            budgetExceeded = true;
+            return false;
+        }
+    }
+    
+    accumulator -= stepSize;
+    frameSteps++;
+    totalSteps++;
+    return true;
+}
+
+void SimulationClock::reset() {
+    accumulator = 0.0;
+    droppedTime = 0.0;
+    frameSteps = 0;
+    totalSteps = 0;
+    budgetExceeded = false;
+}
+
+void SimulationClock::setStepSize(double seconds) {
+    if (seconds > 0.0) stepSize = seconds;
+}
+
+void SimulationClock::setCpuBudget(double milliseconds) {
+    if (milliseconds > 0.0) cpuBudgetMs = milliseconds;
+}
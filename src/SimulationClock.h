@@ -0,0 +1,43 @@
+#pragma once
+#include <chrono>
+
+// Fixed-timestep accumulator. Wall-clock frame time (scaled by the time
+// acceleration) is banked and paid out in equal simulation steps, so the
+// sequence of ticks - and therefore the results - does not depend on the
+// frame rate or the acceleration factor.
+class SimulationClock {
+public:
+    SimulationClock(double stepSize = 0.05, double cpuBudgetMs = 40.0);
+    
+    // Frame control
+    void beginFrame(double simSeconds);
+    bool nextStep();                 // true while a full step is banked and the CPU budget allows
+    void reset();
+    
+    // Configuration
+    void setStepSize(double seconds);
+    void setCpuBudget(double milliseconds);
+    void setMaxBacklog(double seconds) { maxBacklog = seconds; }
+    double getStepSize() const { return stepSize; }
+    double getCpuBudget() const { return cpuBudgetMs; }
+    
+    // Diagnostics
+    int getFrameSteps() const { return frameSteps; }
+    double getBacklog() const { return accumulator; }
+    double getDroppedTime() const { return droppedTime; }
+    double getInterpolation() const { return accumulator / stepSize; } // 0..1 between ticks
+    bool isFallingBehind() const { return budgetExceeded; }
+    long long getTotalSteps() const { return totalSteps; }
+
+private:
+    double stepSize;        // seconds of simulated time per tick
+    double cpuBudgetMs;     // wall-clock budget for the substeps of one frame
+    double maxBacklog;      // seconds of simulated time allowed to queue up
+    double accumulator;     // banked simulated time
+    double droppedTime;     // simulated time discarded because the backlog overflowed
+    
+    int frameSteps;
+    long long totalSteps;
+    bool budgetExceeded;
+    std::chrono::steady_clock::time_point frameStart;
+};
@@ -0,0 +1,30 @@
+#include "SimulationLod.h"
+
+int selectLodInterval(const LodSettings& settings, double distance, double detectionRange,
+                      double moveSpeed, bool alerted, double& safeTime) {
+    safeTime = 0.0;
+    if (alerted || distance <= detectionRange || distance < settings.nearRange) {
+        return 1;
+    }
+    
+    double closingSpeed = (moveSpeed + settings.playerMaxSpeed) / 3600.0; // km/s
+    safeTime = closingSpeed > 0.0 ? (distance - detectionRange) / closingSpeed : 1e9;
+    return distance < settings.farRange ? settings.nearInterval : settings.farInterval;
+}
+
+bool advanceLod(LodState& state, long long tick, double dt) {
+    state.pendingTime += dt;
+    return tick >= state.nextTick || state.pendingTime >= state.safeTime;
+}
+
+void scheduleLod(LodState& state, long long tick, int interval, double safeTime, size_t index) {
+    if (interval < 1) interval = 1;
+    if (interval != state.interval) {
+        state.nextTick = tick + 1 + static_cast<long long>(index % interval);
+    } else {
+        state.nextTick = tick + interval;
+    }
+    state.interval = interval;
+    state.pendingTime = 0.0;
+    state.safeTime = safeTime;
+}
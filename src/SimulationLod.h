@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+
+// Distance-based simulation level of detail. Entities far from the player
+// are updated every few ticks with the dt they accumulated in between.
+struct LodSettings {
+    bool enabled;
+    double nearRange;           // km, closer than this updates every tick
+    double farRange;            // km, closer than this updates every nearInterval ticks
+    int nearInterval;           // ticks between updates inside farRange
+    int farInterval;            // ticks between updates beyond farRange
+    double playerMaxSpeed;      // km/h, bounds how fast the player can close in
+
+    LodSettings()
+        : enabled(true), nearRange(20.0), farRange(100.0), nearInterval(4),
+          farInterval(32), playerMaxSpeed(300.0) {}
+};
+
+// Per-entity scheduling state
+struct LodState {
+    int interval;               // ticks between updates
+    long long nextTick;         // tick of the next scheduled update
+    double pendingTime;         // seconds accumulated since the last update
+    double safeTime;            // seconds the entity can lag before it might be detectable
+
+    LodState() : interval(1), nextTick(0), pendingTime(0.0), safeTime(0.0) {}
+};
+
+// What a tick's update pass needs to know about the player
+struct LodFrame {
+    const LodSettings* settings;
+    double playerX, playerY;    // km
+    long long tick;
+};
+
+// Picks the update interval for an entity distance km away from the player.
+// Alerted entities and anything inside its detection range run every tick;
+// otherwise safeTime is how long the player and entity together need to
+// close to detection range, and the entity is updated before that elapses.
+int selectLodInterval(const LodSettings& settings, double distance, double detectionRange,
+                      double moveSpeed, bool alerted, double& safeTime);
+
+// Accumulates dt and returns true when the entity is due this tick - on its
+// schedule or because it may have reached detection range.
+bool advanceLod(LodState& state, long long tick, double dt);
+
+// Records an update and schedules the next one; index staggers entities
+// that change tier on the same tick so they do not all come due together.
+void scheduleLod(LodState& state, long long tick, int interval, double safeTime, size_t index);
@@ -0,0 +1,59 @@
+#include "Snapshot.h"
+
+// All index and reader-count operations use sequentially consistent
+// ordering: a reader's increment-then-recheck and the writer's
+// publish-then-check must be totally ordered for the handoff to be safe.
+
+SnapshotPublisher::Handle& SnapshotPublisher::Handle::operator=(Handle&& other) {
+    if (this != &other) {
+        release();
+        slot = other.slot;
+        other.slot = nullptr;
+    }
+    return *this;
+}
+
+void SnapshotPublisher::Handle::release() {
+    if (slot) {
+        slot->readers.fetch_sub(1);
+        slot = nullptr;
+    }
+}
+
+SnapshotPublisher::SnapshotPublisher()
+    : current(-1), writing(-1), publishedCount(0), skippedCount(0) {
+}
+
+WorldSnapshot* SnapshotPublisher::beginPublish() {
+    int latest = current.load();
+    for (int i = 0; i < SLOT_COUNT; ++i) {
+        if (i != latest && slots[i].readers.load() == 0) {
+            writing = i;
+            return &slots[i].snapshot;
+        }
+    }
+    skippedCount++;
+    return nullptr;
+}
+
+void SnapshotPublisher::endPublish() {
+    if (writing < 0) return;
+    current.store(writing);
+    writing = -1;
+    publishedCount++;
+}
+
+SnapshotPublisher::Handle SnapshotPublisher::acquire() const {
+    for (;;) {
+        int index = current.load();
+        if (index < 0) return Handle();
+        
+        const Slot& slot = slots[index];
+        slot.readers.fetch_add(1);
+        if (current.load() == index) {
+            return Handle(&slot);
+        }
+        // The writer moved on (and may be refilling this slot) - try again
+        slot.readers.fetch_sub(1);
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+#include "Environment.h"
+
+// Immutable per-tick copies of the world for display, logging and export.
+// Readers on any thread see a consistent tick and never touch live objects.
+
+struct HelicopterSnapshot {
+    std::string name;
+    Position position;
+    FlightParams flightParams;
+    HelicopterSystems systems;
+    double health;
+    double radarRange;
+    int flareCount;
+    int chaffCount;
+};
+
+struct EnemySnapshot {
+    std::string type;
+    EnemyPosition position;
+    int health;
+    int maxHealth;
+    EnemyBehavior behavior;
+    bool isAirborne;
+    double detectionRange;
+    double engagementRange;
+};
+
+struct MissionSnapshot {
+    bool active;
+    std::string name;
+    MissionStatus status;
+    double progress;            // 0.0 to 1.0
+    double timeLimit;           // minutes, <= 0 for no limit
+    double timeRemaining;       // minutes
+    std::vector<Objective> objectives;
+};
+
+struct EnvironmentSnapshot {
+    WeatherCondition weather;
+    TerrainType terrain;
+    double timeOfDay;
+    double windSpeed;
+    double windDirection;
+    double visibility;
+};
+
+struct WorldSnapshot {
+    long long tick;
+    double gameTime;            // seconds
+    HelicopterSnapshot helicopter;
+    std::vector<EnemySnapshot> enemies;
+    MissionSnapshot mission;
+    EnvironmentSnapshot environment;
+};
+
+// Single-writer, many-reader publication without locks. The simulation
+// fills a slot no reader holds and then swings the "current" index to it;
+// readers pin the current slot with a reference count and re-check the
+// index, backing off if it moved underneath them. If every spare slot is
+// still pinned the writer skips that tick instead of waiting.
+class SnapshotPublisher {
+private:
+    struct Slot {
+        WorldSnapshot snapshot;
+        mutable std::atomic<int> readers;
+        Slot() : readers(0) {}
+    };
+
+public:
+    static const int SLOT_COUNT = 4;
+    
+    // Pins one published snapshot for as long as it is held
+    class Handle {
+    public:
+        Handle() : slot(nullptr) {}
+        Handle(Handle&& other) : slot(other.slot) { other.slot = nullptr; }
+        Handle& operator=(Handle&& other);
+        ~Handle() { release(); }
+        
+        const WorldSnapshot* get() const { return slot ? &slot->snapshot : nullptr; }
+        const WorldSnapshot* operator->() const { return get(); }
+        const WorldSnapshot& operator*() const { return slot->snapshot; }
+        explicit operator bool() const { return slot != nullptr; }
+    
+    private:
+        friend class SnapshotPublisher;
+        explicit Handle(const Slot* pinned) : slot(pinned) {}
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        void release();
+        
+        const Slot* slot;
+    };
+    
+    SnapshotPublisher();
+    
+    // Writer side (simulation thread only)
+    WorldSnapshot* beginPublish();      // nullptr if every spare slot is pinned
+    void endPublish();
+    
+    // Reader side (any thread)
+    Handle acquire() const;
+    
+    long long getPublishedCount() const { return publishedCount; }
+    long long getSkippedCount() const { return skippedCount; }
+
+private:
+    Slot slots[SLOT_COUNT];
+    std::atomic<int> current;           // -1 until the first publish
+    int writing;                        // slot being filled, -1 if none
+    long long publishedCount;
+    long long skippedCount;
+};
@@ -0,0 +1,237 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+static const size_t MIN_BUCKETS = 64;
+
+SpatialGrid::SpatialGrid(double cellSize)
+    : cellSize(cellSize > 0.0 ? cellSize : 1.0), inverseCellSize(1.0 / this->cellSize), units(nullptr), current(false), revision(0),
+      bucketMask(0), minCellX(0), minCellY(0), maxCellX(-1), maxCellY(-1), rebuilds(0), moves(0) {}
+
+int32_t SpatialGrid::cellCoordinate(double km) const {
+    double cell = std::floor(km * inverseCellSize);
+    return static_cast<int32_t>(std::max(-1e9, std::min(1e9, cell)));
+}
+
+uint64_t SpatialGrid::cellKey(int32_t cx, int32_t cy) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+}
+
+size_t SpatialGrid::bucketOf(uint64_t key) const {
+    // Spread neighbouring cells over the table
+    uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> 32) & bucketMask;
+}
+
+void SpatialGrid::link(int32_t slot, uint64_t key) {
+    size_t bucket = bucketOf(key);
+    Node& node = nodes[slot];
+    node.cell = key;
+    node.prev = -1;
+    node.next = buckets[bucket];
+    if (buckets[bucket] >= 0) nodes[buckets[bucket]].prev = slot;
+    buckets[bucket] = slot;
+}
+
+void SpatialGrid::unlink(int32_t slot) {
+    const Node& node = nodes[slot];
+    if (node.prev >= 0) {
+        nodes[node.prev].next = node.next;
+    } else {
+        buckets[bucketOf(node.cell)] = node.next;
+    }
+    if (node.next >= 0) nodes[node.next].prev = node.prev;
+}
+
+void SpatialGrid::expandBounds(int32_t cx, int32_t cy) {
+    minCellX = std::min(minCellX, cx);
+    minCellY = std::min(minCellY, cy);
+    maxCellX = std::max(maxCellX, cx);
+    maxCellY = std::max(maxCellY, cy);
+}
+
+void SpatialGrid::rebuild(const EnemyStore& store) {
+    // Two buckets per unit keeps lists short; tables only grow, so a
+    // steady population rebuilds without allocating
+    size_t bucketCount = MIN_BUCKETS;
+    while (bucketCount < 2 * store.size()) bucketCount *= 2;
+    bucketCount = std::max(bucketCount, buckets.size());
+    buckets.assign(bucketCount, -1);
+    bucketMask = bucketCount - 1;
+    for (Node& node : nodes) {
+        node.generation = 0;
+    }
+
+    minCellX = minCellY = 0;
+    maxCellX = maxCellY = -1;
+    for (size_t i = 0; i < store.size(); ++i) {
+        const EnemyPosition& pos = store[i].getPosition();
+        int32_t cx = cellCoordinate(pos.x);
+        int32_t cy = cellCoordinate(pos.y);
+        if (i == 0) {
+            minCellX = maxCellX = cx;
+            minCellY = maxCellY = cy;
+        }
+        expandBounds(cx, cy);
+
+        EnemyHandle handle = store.getHandle(i);
+        if (handle.slot >= nodes.size()) {
+            nodes.resize(handle.slot + 1, Node{ 0, -1, -1, 0 });
+        }
+        nodes[handle.slot].generation = handle.generation;
+        link(static_cast<int32_t>(handle.slot), cellKey(cx, cy));
+    }
+    rebuilds++;
+}
+
+void SpatialGrid::update(const EnemyStore& store) {
+    if (units != &store || revision != store.getRevision()) {
+        units = &store;
+        revision = store.getRevision();
+        rebuild(store);
+        current = true;
+        return;
+    }
+    if (current) return;
+
+    for (size_t i = 0; i < store.size(); ++i) {
+        const EnemyPosition& pos = store[i].getPosition();
+        int32_t cx = cellCoordinate(pos.x);
+        int32_t cy = cellCoordinate(pos.y);
+        uint64_t key = cellKey(cx, cy);
+        int32_t slot = static_cast<int32_t>(store.getHandle(i).slot);
+        if (nodes[slot].cell == key) continue;
+        unlink(slot);
+        link(slot, key);
+        expandBounds(cx, cy);
+        moves++;
+    }
+    current = true;
+}
+
+template <typename Visit>
+void SpatialGrid::visitCell(int32_t cx, int32_t cy, double x, double y, Visit visit) const {
+    // Other cells hash into the same bucket; their units are skipped
+    uint64_t key = cellKey(cx, cy);
+    for (int32_t slot = buckets[bucketOf(key)]; slot >= 0; slot = nodes[slot].next) {
+        const Node& node = nodes[slot];
+        if (node.cell != key) continue;
+        int index = units->indexOf(EnemyHandle(static_cast<uint32_t>(slot), node.generation));
+        const EnemyPosition& pos = (*units)[static_cast<size_t>(index)].getPosition();
+        double dx = pos.x - x;
+        double dy = pos.y - y;
+        visit(static_cast<size_t>(index), dx * dx + dy * dy);
+    }
+}
+
+void SpatialGrid::queryRadius(double x, double y, double radius, std::vector<size_t>& matches) const {
+    matches.clear();
+    if (!units || radius < 0.0) return;
+    double radiusSquared = radius * radius;
+    auto inRange = [&matches, radiusSquared](size_t index, double distanceSquared) {
+        if (distanceSquared <= radiusSquared) matches.push_back(index);
+    };
+
+    int32_t x0 = std::max(cellCoordinate(x - radius), minCellX);
+    int32_t x1 = std::min(cellCoordinate(x + radius), maxCellX);
+    int32_t y0 = std::max(cellCoordinate(y - radius), minCellY);
+    int32_t y1 = std::min(cellCoordinate(y + radius), maxCellY);
+    if (x0 > x1 || y0 > y1) return;
+
+    double cellCount = (static_cast<double>(x1) - x0 + 1) * (static_cast<double>(y1) - y0 + 1);
+    if (cellCount > static_cast<double>(units->size())) {
+        // Covers most of the world, a scan is cheaper than the cells
+        for (size_t i = 0; i < units->size(); ++i) {
+            const EnemyPosition& pos = (*units)[i].getPosition();
+            double dx = pos.x - x;
+            double dy = pos.y - y;
+            inRange(i, dx * dx + dy * dy);
+        }
+        return;
+    }
+    for (int32_t cx = x0; cx <= x1; ++cx) {
+        for (int32_t cy = y0; cy <= y1; ++cy) {
+            visitCell(cx, cy, x, y, inRange);
+        }
+    }
+    std::sort(matches.begin(), matches.end());
+}
+
+void SpatialGrid::queryRect(double minX, double minY, double maxX, double maxY,
+                            std::vector<size_t>& matches) const {
+    matches.clear();
+    if (!units || minX > maxX || minY > maxY) return;
+    auto inside = [&matches, this, minX, minY, maxX, maxY](size_t index, double) {
+        const EnemyPosition& pos = (*units)[index].getPosition();
+        if (pos.x >= minX && pos.x <= maxX && pos.y >= minY && pos.y <= maxY) matches.push_back(index);
+    };
+
+    int32_t x0 = std::max(cellCoordinate(minX), minCellX);
+    int32_t x1 = std::min(cellCoordinate(maxX), maxCellX);
+    int32_t y0 = std::max(cellCoordinate(minY), minCellY);
+    int32_t y1 = std::min(cellCoordinate(maxY), maxCellY);
+    if (x0 > x1 || y0 > y1) return;
+
+    double cellCount = (static_cast<double>(x1) - x0 + 1) * (static_cast<double>(y1) - y0 + 1);
+    if (cellCount > static_cast<double>(units->size())) {
+        for (size_t i = 0; i < units->size(); ++i) {
+            inside(i, 0.0);
+        }
+        return;
+    }
+    for (int32_t cx = x0; cx <= x1; ++cx) {
+        for (int32_t cy = y0; cy <= y1; ++cy) {
+            visitCell(cx, cy, minX, minY, inside);
+        }
+    }
+    std::sort(matches.begin(), matches.end());
+}
+
+void SpatialGrid::queryNearest(double x, double y, size_t k, std::vector<size_t>& matches) const {
+    matches.clear();
+    if (!units || k == 0 || units->empty()) return;
+    nearest.clear();
+    auto collect = [this](size_t index, double distanceSquared) {
+        nearest.push_back(std::make_pair(distanceSquared, index));
+    };
+
+    // Search square rings of cells outwards. Everything in ring r + 1 is at
+    // least r cells away, so stop once the k-th best is closer than that.
+    int32_t cx = cellCoordinate(x);
+    int32_t cy = cellCoordinate(y);
+    int32_t lastRing = std::max(std::max(cx - minCellX, maxCellX - cx), std::max(cy - minCellY, maxCellY - cy));
+    k = std::min(k, units->size());
+    size_t cellsVisited = 0;
+    for (int32_t ring = 0; ring <= lastRing; ++ring) {
+        cellsVisited += ring == 0 ? 1 : 8 * static_cast<size_t>(ring);
+        if (cellsVisited > units->size()) {
+            // Far from everyone, a scan is cheaper than the empty rings
+            nearest.clear();
+            for (size_t i = 0; i < units->size(); ++i) {
+                const EnemyPosition& pos = (*units)[i].getPosition();
+                double dx = pos.x - x;
+                double dy = pos.y - y;
+                collect(i, dx * dx + dy * dy);
+            }
+            break;
+        }
+        for (int32_t ix = cx - ring; ix <= cx + ring; ++ix) {
+            // Full rows at the top and bottom, just the two ends in between
+            bool edgeRow = ix == cx - ring || ix == cx + ring;
+            for (int32_t iy = cy - ring; iy <= cy + ring; iy += edgeRow ? 1 : std::max(1, 2 * ring)) {
+                visitCell(ix, iy, x, y, collect);
+            }
+        }
+        if (nearest.size() >= k) {
+            std::nth_element(nearest.begin(), nearest.begin() + (k - 1), nearest.end());
+            double reach = ring * cellSize;
+            if (nearest[k - 1].first <= reach * reach) break;
+        }
+    }
+
+    // Ties go to the lower index, as a scan keeping the first minimum would
+    std::partial_sort(nearest.begin(), nearest.begin() + k, nearest.end());
+    for (size_t i = 0; i < k; ++i) {
+        matches.push_back(nearest[i].second);
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "EnemyStore.h"
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// Uniform grid over the (x, y) positions of an EnemyStore's units, hashed
+// into a power-of-two bucket table so the world needs no fixed bounds.
+// Units are tracked by handle slot, so reordering the store does not touch
+// the grid. Each unit sits in an intrusive list for its bucket; moving to
+// another cell is an unlink and a relink, with no allocation.
+//
+// update() rebuilds the grid when units were added or removed and otherwise
+// only relinks the units whose cell changed. Queries read positions from the
+// store, so it must not change between update() and the queries that follow.
+// Queries share scratch space and are not thread-safe.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(double cellSize = 5.0);
+
+    void update(const EnemyStore& units);
+    void invalidate() { current = false; }
+    bool isCurrent() const { return current; }
+
+    // Unit indices in ascending order, like the linear scan they replace
+    void queryRadius(double x, double y, double radius, std::vector<size_t>& matches) const;
+    void queryRect(double minX, double minY, double maxX, double maxY, std::vector<size_t>& matches) const;
+    // The k units closest to (x, y), nearest first
+    void queryNearest(double x, double y, size_t k, std::vector<size_t>& matches) const;
+
+    double getCellSize() const { return cellSize; }
+    long long getRebuilds() const { return rebuilds; }
+    long long getMoves() const { return moves; }       // cell changes applied incrementally
+
+private:
+    double cellSize;
+    double inverseCellSize;
+    const EnemyStore* units;
+    bool current;
+    unsigned long long revision;
+
+    // Per handle slot, together so a bucket walk touches one line per unit
+    struct Node {
+        uint64_t cell;                  // packed cell coordinates
+        int32_t next;                   // bucket list links, -1 at the ends
+        int32_t prev;
+        uint32_t generation;            // 0 when the slot is not in the grid
+    };
+    std::vector<Node> nodes;
+
+    std::vector<int32_t> buckets;       // first slot of each bucket's list
+    size_t bucketMask;
+    int32_t minCellX, minCellY, maxCellX, maxCellY;     // bounds every unit has been inside
+
+    mutable std::vector<std::pair<double, size_t>> nearest;    // queryNearest scratch
+
+    long long rebuilds;
+    long long moves;
+
+    int32_t cellCoordinate(double km) const;
+    static uint64_t cellKey(int32_t cx, int32_t cy);
+    size_t bucketOf(uint64_t key) const;
+    void link(int32_t slot, uint64_t key);
+    void unlink(int32_t slot);
+    void rebuild(const EnemyStore& store);
+    void expandBounds(int32_t cx, int32_t cy);
+
+    // Calls visit(index, distanceSquared) for every unit in the cell
+    template <typename Visit>
+    void visitCell(int32_t cx, int32_t cy, double x, double y, Visit visit) const;
+};
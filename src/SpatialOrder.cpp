@@ -0,0 +1,143 @@
+#include "SpatialOrder.h"
+#include "EnemyStore.h"
+#include <algorithm>
+#include <cmath>
+
+static const double MORTON_CELL_SIZE = 0.1;   // km
+static const double MORTON_ORIGIN = 32768.0;  // cells, puts (0, 0) mid-grid
+
+static uint32_t spreadBits(uint32_t value) {
+    // 16 bits -> every other bit of 32
+    value &= 0x0000ffff;
+    value = (value | (value << 8)) & 0x00ff00ff;
+    value = (value | (value << 4)) & 0x0f0f0f0f;
+    value = (value | (value << 2)) & 0x33333333;
+    value = (value | (value << 1)) & 0x55555555;
+    return value;
+}
+
+static uint32_t gridCell(double km) {
+    double cell = std::floor(km / MORTON_CELL_SIZE) + MORTON_ORIGIN;
+    return static_cast<uint32_t>(std::min(65535.0, std::max(0.0, cell)));
+}
+
+uint32_t mortonKey(double x, double y) {
+    return spreadBits(gridCell(x)) | (spreadBits(gridCell(y)) << 1);
+}
+
+SpatialOrder::SpatialOrder(size_t budget, int restTicks)
+    : budget(std::max<size_t>(budget, 8)), swapBudget(this->budget / 8), restTicks(restTicks), stage(Stage::RESTING), cursor(0),
+      pass(0), restRemaining(0), revision(0), completedSorts(0), abandonedSorts(0) {
+    swaps.reserve(swapBudget);
+}
+
+void SpatialOrder::begin(const EnemyStore& store) {
+    // Scratch keeps its capacity, so only a growing population allocates
+    size_t count = store.size();
+    keys.resize(count);
+    sorted.resize(count);
+    where.resize(count);
+    at.resize(count);
+    revision = store.getRevision();
+    stage = Stage::KEYING;
+    cursor = 0;
+    pass = 0;
+}
+
+const std::vector<std::pair<size_t, size_t>>& SpatialOrder::step(const EnemyStore& store) {
+    swaps.clear();
+    
+    if (stage == Stage::RESTING) {
+        if (restRemaining-- > 0 || store.size() < 2) return swaps;
+        begin(store);
+    } else if (store.getRevision() != revision) {
+        // Units came or went, so the keyed indices no longer line up
+        abandonedSorts++;
+        begin(store);
+    }
+    
+    size_t count = keys.size();
+    size_t end = std::min(count, cursor + budget);
+    switch (stage) {
+        case Stage::KEYING:
+            for (size_t i = cursor; i < end; ++i) {
+                const EnemyPosition& pos = store[i].getPosition();
+                keys[i] = std::make_pair(mortonKey(pos.x, pos.y), static_cast<uint32_t>(i));
+                where[i] = static_cast<uint32_t>(i);
+                at[i] = static_cast<uint32_t>(i);
+            }
+            break;
+        
+        case Stage::COUNTING:
+            if (cursor == 0) std::fill(buckets, buckets + 256, 0);
+            for (size_t i = cursor; i < end; ++i) {
+                buckets[(keys[i].first >> (pass * 8)) & 0xff]++;
+            }
+            if (end == count) {
+                // Counts become each byte value's first output slot
+                size_t offset = 0;
+                for (size_t& bucket : buckets) {
+                    size_t size = bucket;
+                    bucket = offset;
+                    offset += size;
+                }
+            }
+            break;
+        
+        case Stage::SCATTERING:
+            // In input order, so every pass is stable and equal keys keep index order
+            for (size_t i = cursor; i < end; ++i) {
+                sorted[buckets[(keys[i].first >> (pass * 8)) & 0xff]++] = keys[i];
+            }
+            break;
+        
+        case Stage::APPLYING: {
+            // Bring the k-th unit in curve order into index k, following
+            // where earlier swaps have moved everyone. A swap touches every
+            // column of two units, so it counts for more than a key.
+            size_t k = cursor;
+            for (; k < end && swaps.size() < swapBudget; ++k) {
+                uint32_t unit = keys[k].second;
+                uint32_t from = where[unit];
+                if (from == k) continue;
+                uint32_t displaced = at[k];
+                swaps.push_back(std::make_pair(k, static_cast<size_t>(from)));
+                at[from] = displaced;
+                where[displaced] = from;
+                at[k] = unit;
+                where[unit] = static_cast<uint32_t>(k);
+            }
+            end = k;
+            break;
+        }
+        
+        case Stage::RESTING:
+            break;
+    }
+    
+    cursor = end;
+    if (cursor < count) return swaps;
+    
+    // Stage finished, move to the next
+    cursor = 0;
+    switch (stage) {
+        case Stage::KEYING:
+            stage = Stage::COUNTING;
+            break;
+        case Stage::COUNTING:
+            stage = Stage::SCATTERING;
+            break;
+        case Stage::SCATTERING:
+            keys.swap(sorted);
+            stage = ++pass < 4 ? Stage::COUNTING : Stage::APPLYING;
+            break;
+        case Stage::APPLYING:
+            completedSorts++;
+            restRemaining = restTicks;
+            stage = Stage::RESTING;
+            break;
+        case Stage::RESTING:
+            break;
+    }
+    return swaps;
+}
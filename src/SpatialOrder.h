@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+class EnemyStore;
+
+// Z-order (Morton) key of a position: the bits of its 0.1 km grid cell,
+// interleaved, so positions near each other mostly get nearby keys
+uint32_t mortonKey(double x, double y);
+
+// Re-sorts a store along the Morton curve so units close in space sit close
+// in memory, a budget of units per step. A sort keys every unit, radix-sorts
+// the keys 8 bits a pass and then applies the order as swaps; each stage
+// works through the population in budget-sized chunks (an eighth of the
+// budget when swapping). Adding or removing
+// units abandons the sort in progress and the next step starts over.
+class SpatialOrder {
+public:
+    explicit SpatialOrder(size_t budget = 4096, int restTicks = 200);
+    
+    // Advances the sort by one step and returns the swaps (applied in order)
+    // it wants made; the caller applies them to the store and to anything
+    // indexed like it. Empty while resting or still keying and sorting.
+    const std::vector<std::pair<size_t, size_t>>& step(const EnemyStore& store);
+    
+    bool isSorting() const { return stage != Stage::RESTING; }
+    long long getCompletedSorts() const { return completedSorts; }
+    long long getAbandonedSorts() const { return abandonedSorts; }
+
+private:
+    enum class Stage { RESTING, KEYING, COUNTING, SCATTERING, APPLYING };
+    
+    size_t budget;              // units keyed, counted or scattered per step
+    size_t swapBudget;          // swaps made per step while applying the order
+    int restTicks;              // steps between the end of one sort and the next
+    Stage stage;
+    size_t cursor;              // progress through the current stage
+    int pass;                   // radix pass, 0-3 from the low byte up
+    int restRemaining;
+    unsigned long long revision;    // store revision the sort was started on
+    long long completedSorts;
+    long long abandonedSorts;
+    
+    std::vector<std::pair<uint32_t, uint32_t>> keys;    // (key, unit index at the start)
+    std::vector<std::pair<uint32_t, uint32_t>> sorted;  // scatter target, swapped with keys
+    size_t buckets[256];
+    std::vector<uint32_t> where;    // start index -> current index of that unit
+    std::vector<uint32_t> at;       // current index -> start index of the unit there
+    std::vector<std::pair<size_t, size_t>> swaps;
+    
+    void begin(const EnemyStore& store);
+};
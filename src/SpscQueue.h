@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+// Bounded single-producer / single-consumer ring buffer. push() is only
+// called from one thread and pop() from one other thread; neither blocks.
+template <typename T, size_t Capacity>
+class SpscQueue {
+public:
+    SpscQueue() : head(0), tail(0) {}
+    
+    bool push(T&& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t next = (t + 1) % Capacity;
+        if (next == head.load(std::memory_order_acquire)) return false; // full
+        slots[t] = std::move(value);
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+    
+    bool pop(T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false; // empty
+        value = std::move(slots[h]);
+        head.store((h + 1) % Capacity, std::memory_order_release);
+        return true;
+    }
+    
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<T, Capacity> slots;
+    std::atomic<size_t> head;   // next slot to read (consumer)
+    std::atomic<size_t> tail;   // next slot to write (producer)
+};
@@ -0,0 +1,173 @@
+#include "TaskGraph.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+
+// Task currently executing on this thread, for checkAccess()
+struct RunningTask {
+    TaskGraph* graph;
+    const char* name;
+    unsigned reads;
+    unsigned writes;
+};
+static thread_local RunningTask currentTask = { nullptr, nullptr, 0, 0 };
+
+static const char* resourceName(int bit) {
+    switch (1u << bit) {
+        case RESOURCE_HELICOPTER: return "helicopter";
+        case RESOURCE_ENEMIES: return "enemies";
+        case RESOURCE_ENVIRONMENT: return "environment";
+        case RESOURCE_MISSION: return "mission";
+        case RESOURCE_GAME_STATE: return "game state";
+        default: return "unknown";
+    }
+}
+
+TaskGraph::TaskGraph() : remaining(0), activePool(nullptr), raceChecking(false), raceViolations(0) {
+    for (int i = 0; i < SIM_RESOURCE_COUNT; ++i) {
+        activeReaders[i] = 0;
+        activeWriters[i] = 0;
+    }
+}
+
+int TaskGraph::addTask(const std::string& name, unsigned reads, unsigned writes, std::function<void()> work) {
+    Task task;
+    task.name = name;
+    task.reads = reads;
+    task.writes = writes;
+    task.work = std::move(work);
+    task.lastMs = 0.0;
+    
+    int index = static_cast<int>(tasks.size());
+    for (int i = 0; i < index; ++i) {
+        const Task& earlier = tasks[i];
+        bool conflict = (earlier.writes & (reads | writes)) || (earlier.reads & writes);
+        if (conflict) {
+            task.dependencies.push_back(i);
+            tasks[i].dependents.push_back(index);
+        }
+    }
+    
+    tasks.push_back(std::move(task));
+    pending.reset(new std::atomic<int>[tasks.size()]);
+    return index;
+}
+
+void TaskGraph::clear() {
+    tasks.clear();
+    pending.reset();
+}
+
+void TaskGraph::run(ThreadPool* pool) {
+    if (tasks.empty()) return;
+    
+    // Declaration order is a valid topological order
+    if (!pool || pool->getWorkerCount() == 0) {
+        activePool = nullptr;
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            runTask(static_cast<int>(i));
+        }
+        return;
+    }
+    
+    activePool = pool;
+    remaining.store(static_cast<int>(tasks.size()));
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        pending[i].store(static_cast<int>(tasks[i].dependencies.size()));
+    }
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].dependencies.empty()) {
+            pool->submit(&TaskGraph::executeTask, this, i);
+        }
+    }
+    
+    // Help out until the whole tick is done
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!pool->runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+    activePool = nullptr;
+}
+
+void TaskGraph::executeTask(void* graph, size_t index) {
+    TaskGraph* self = static_cast<TaskGraph*>(graph);
+    int taskIndex = static_cast<int>(index);
+    self->runTask(taskIndex);
+    
+    for (int dependent : self->tasks[taskIndex].dependents) {
+        if (self->pending[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            self->activePool->submit(&TaskGraph::executeTask, self, static_cast<size_t>(dependent));
+        }
+    }
+    self->remaining.fetch_sub(1, std::memory_order_release);
+}
+
+void TaskGraph::runTask(int index) {
+    Task& task = tasks[index];
+    if (raceChecking) claimResources(index);
+    
+    RunningTask previous = currentTask;
+    currentTask = RunningTask{ this, task.name.c_str(), task.reads, task.writes };
+    AllocationStats allocationsBefore = threadAllocations();
+    auto start = std::chrono::steady_clock::now();
+    task.work();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    task.lastMs = elapsed.count();
+    task.lastAllocations = threadAllocations() - allocationsBefore;
+    currentTask = previous;
+    
+    if (raceChecking) releaseResources(index);
+}
+
+void TaskGraph::claimResources(int index) {
+    const Task& task = tasks[index];
+    for (int bit = 0; bit < SIM_RESOURCE_COUNT; ++bit) {
+        unsigned mask = 1u << bit;
+        if (task.writes & mask) {
+            int writers = activeWriters[bit].fetch_add(1);
+            int readers = activeReaders[bit].load();
+            if (writers > 0 || readers > 0) {
+                reportViolation("task '" + task.name + "' writes " + resourceName(bit) +
+                                " while another task is using it");
+            }
+        } else if (task.reads & mask) {
+            activeReaders[bit].fetch_add(1);
+            if (activeWriters[bit].load() > 0) {
+                reportViolation("task '" + task.name + "' reads " + resourceName(bit) +
+                                " while another task is writing it");
+            }
+        }
+    }
+}
+
+void TaskGraph::releaseResources(int index) {
+    const Task& task = tasks[index];
+    for (int bit = 0; bit < SIM_RESOURCE_COUNT; ++bit) {
+        unsigned mask = 1u << bit;
+        if (task.writes & mask) {
+            activeWriters[bit].fetch_sub(1);
+        } else if (task.reads & mask) {
+            activeReaders[bit].fetch_sub(1);
+        }
+    }
+}
+
+void TaskGraph::reportViolation(const std::string& message) {
+    raceViolations.fetch_add(1);
+    std::cerr << "[RACE] " << message << std::endl;
+}
+
+void TaskGraph::checkAccess(SimResource resource, bool write) {
+    TaskGraph* graph = currentTask.graph;
+    if (!graph || !graph->raceChecking) return;
+    
+    unsigned allowed = write ? currentTask.writes : (currentTask.reads | currentTask.writes);
+    if (!(allowed & resource)) {
+        int bit = 0;
+        while ((1u << bit) != static_cast<unsigned>(resource)) bit++;
+        graph->reportViolation(std::string("task '") + currentTask.name + "' " +
+                               (write ? "writes " : "reads ") + resourceName(bit) +
+                               " without declaring it");
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include "ThreadPool.h"
+#include "AllocationCounter.h"
+
+// World state touched by the per-tick phases
+enum SimResource : unsigned {
+    RESOURCE_HELICOPTER  = 1u << 0,
+    RESOURCE_ENEMIES     = 1u << 1,
+    RESOURCE_ENVIRONMENT = 1u << 2,
+    RESOURCE_MISSION     = 1u << 3,
+    RESOURCE_GAME_STATE  = 1u << 4
+};
+const int SIM_RESOURCE_COUNT = 5;
+
+// Per-tick work described as tasks with declared read/write sets. A task
+// depends on every earlier task it conflicts with (write/read, read/write
+// or write/write), so running the graph gives the same result as running
+// the tasks in declaration order while letting independent ones overlap.
+class TaskGraph {
+public:
+    TaskGraph();
+    
+    int addTask(const std::string& name, unsigned reads, unsigned writes, std::function<void()> work);
+    void run(ThreadPool* pool);                 // nullptr or no workers runs inline in order
+    void clear();
+    
+    size_t getTaskCount() const { return tasks.size(); }
+    const std::string& getTaskName(int index) const { return tasks[index].name; }
+    const std::vector<int>& getDependencies(int index) const { return tasks[index].dependencies; }
+    double getTaskTime(int index) const { return tasks[index].lastMs; }   // wall ms of the last run
+    // Heap allocations of the last run, on the thread that ran the task
+    const AllocationStats& getTaskAllocations(int index) const { return tasks[index].lastAllocations; }
+    
+    // Debug race checking: phases report the state they actually touch and
+    // concurrently running tasks are checked for overlapping claims.
+    void setRaceChecking(bool enabled) { raceChecking = enabled; }
+    bool isRaceChecking() const { return raceChecking; }
+    int getRaceViolations() const { return raceViolations.load(); }
+    static void checkAccess(SimResource resource, bool write);
+
+private:
+    struct Task {
+        std::string name;
+        unsigned reads;
+        unsigned writes;
+        std::function<void()> work;
+        std::vector<int> dependencies;
+        std::vector<int> dependents;
+        double lastMs;
+        AllocationStats lastAllocations;
+    };
+    
+    std::vector<Task> tasks;
+    std::unique_ptr<std::atomic<int>[]> pending;    // unfinished dependencies per task
+    std::atomic<int> remaining;
+    ThreadPool* activePool;
+    
+    bool raceChecking;
+    std::atomic<int> raceViolations;
+    std::atomic<int> activeReaders[SIM_RESOURCE_COUNT];
+    std::atomic<int> activeWriters[SIM_RESOURCE_COUNT];
+    
+    static void executeTask(void* graph, size_t index);
+    void runTask(int index);
+    void claimResources(int index);
+    void releaseResources(int index);
+    void reportViolation(const std::string& message);
+    
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+};
@@ -0,0 +1,184 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+// Pool and deque index of the worker running on this thread
+static thread_local const ThreadPool* currentPool = nullptr;
+static thread_local int currentWorker = -1;
+
+void ThreadPool::WorkQueue::pushBack(const Job& job) {
+    if (count == jobs.size()) {
+        // Unroll the ring into a larger buffer
+        std::vector<Job> larger(jobs.size() * 2);
+        for (size_t i = 0; i < count; ++i) {
+            larger[i] = jobs[(head + i) % jobs.size()];
+        }
+        jobs.swap(larger);
+        head = 0;
+    }
+    jobs[(head + count) % jobs.size()] = job;
+    count++;
+}
+
+bool ThreadPool::WorkQueue::popBack(Job& job) {
+    if (count == 0) return false;
+    count--;
+    job = jobs[(head + count) % jobs.size()];
+    return true;
+}
+
+bool ThreadPool::WorkQueue::popFront(Job& job) {
+    if (count == 0) return false;
+    job = jobs[head];
+    head = (head + 1) % jobs.size();
+    count--;
+    return true;
+}
+
+ThreadPool::ThreadPool(int workerCount)
+    : queuedJobs(0), nextQueue(0), steals(0), stopping(false) {
+    for (int i = 0; i < workerCount; ++i) {
+        queues.emplace_back(new WorkQueue());
+    }
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::currentWorkerIndex() const {
+    return currentPool == this ? currentWorker : -1;
+}
+
+void ThreadPool::submit(JobFunction function, void* context, size_t index) {
+    if (queues.empty()) {
+        function(context, index);
+        return;
+    }
+    
+    // Workers keep their own jobs local; everyone else spreads them out
+    int owner = currentWorkerIndex();
+    if (owner < 0) {
+        owner = static_cast<int>(nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size());
+    }
+    
+    WorkQueue& queue = *queues[owner];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.pushBack(Job{function, context, index});
+    }
+    queuedJobs.fetch_add(1);
+    
+    // Taking the idle lock orders this push before any worker's wait predicate
+    { std::lock_guard<std::mutex> lock(idleMutex); }
+    jobAvailable.notify_one();
+}
+
+bool ThreadPool::findJob(int workerIndex, Job& job) {
+    if (queuedJobs.load() == 0) return false;
+    
+    if (workerIndex >= 0) {
+        WorkQueue& own = *queues[workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.popBack(job)) {
+            queuedJobs.fetch_sub(1);
+            return true;
+        }
+    }
+    
+    // Steal the oldest job from the next busy deque
+    size_t queueCount = queues.size();
+    size_t start = workerIndex >= 0 ? static_cast<size_t>(workerIndex) + 1 : 0;
+    for (size_t i = 0; i < queueCount; ++i) {
+        size_t victim = (start + i) % queueCount;
+        if (static_cast<int>(victim) == workerIndex) continue;
+        WorkQueue& queue = *queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.popFront(job)) {
+            queuedJobs.fetch_sub(1);
+            steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::runPendingJob() {
+    Job job;
+    if (!findJob(currentWorkerIndex(), job)) return false;
+    job.function(job.context, job.index);
+    return true;
+}
+
+void ThreadPool::workerLoop(int workerIndex) {
+    currentPool = this;
+    currentWorker = workerIndex;
+    
+    for (;;) {
+        Job job;
+        if (findJob(workerIndex, job)) {
+            job.function(job.context, job.index);
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(idleMutex);
+        jobAvailable.wait(lock, [this]() { return stopping || queuedJobs.load() > 0; });
+        if (stopping && queuedJobs.load() == 0) return;
+    }
+}
+
+// Shared by the chunks of one parallelFor call; lives on the caller's stack
+struct ParallelForState {
+    ThreadPool::RangeFunction function;
+    void* context;
+    size_t count;
+    size_t grain;
+    std::atomic<size_t> remaining;
+};
+
+void ThreadPool::runChunk(void* state, size_t chunk) {
+    ParallelForState* loop = static_cast<ParallelForState*>(state);
+    size_t begin = chunk * loop->grain;
+    size_t end = std::min(loop->count, begin + loop->grain);
+    loop->function(loop->context, begin, end);
+    loop->remaining.fetch_sub(1, std::memory_order_release);
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, RangeFunction function, void* context) {
+    if (count == 0) return;
+    grain = std::max<size_t>(1, grain);
+    size_t chunks = (count + grain - 1) / grain;
+    
+    if (queues.empty() || chunks == 1) {
+        function(context, 0, count);
+        return;
+    }
+    
+    ParallelForState state;
+    state.function = function;
+    state.context = context;
+    state.count = count;
+    state.grain = grain;
+    state.remaining.store(chunks);
+    
+    // Keep the first chunk for ourselves, the rest is up for grabs
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        submit(&ThreadPool::runChunk, &state, chunk);
+    }
+    runChunk(&state, 0);
+    
+    while (state.remaining.load(std::memory_order_acquire) > 0) {
+        if (!runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+}
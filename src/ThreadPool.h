@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+// Persistent worker threads with one job deque each. Owners pop their newest
+// job, idle workers steal the oldest job from someone else. Jobs are a plain
+// function pointer plus context so submitting one never allocates.
+class ThreadPool {
+public:
+    typedef void (*JobFunction)(void* context, size_t index);
+    typedef void (*RangeFunction)(void* context, size_t begin, size_t end);
+    
+    explicit ThreadPool(int workerCount);
+    ~ThreadPool();
+    
+    int getWorkerCount() const { return static_cast<int>(workers.size()); }
+    
+    void submit(JobFunction function, void* context, size_t index);
+    bool runPendingJob();       // lets the calling thread help; false if nothing was queued
+    
+    // Splits [0, count) into chunks of at most grain items and runs them on
+    // the pool and the calling thread. Returns once every chunk has finished.
+    void parallelFor(size_t count, size_t grain, RangeFunction function, void* context);
+    
+    long long getStealCount() const { return steals.load(); }
+
+private:
+    struct Job {
+        JobFunction function;
+        void* context;
+        size_t index;
+    };
+    
+    // Ring buffer deque, grows when full
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        size_t head;
+        size_t count;
+        
+        WorkQueue() : jobs(64), head(0), count(0) {}
+        void pushBack(const Job& job);
+        bool popBack(Job& job);
+        bool popFront(Job& job);
+    };
+    
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues;  // one per worker
+    std::atomic<int> queuedJobs;
+    std::atomic<unsigned> nextQueue;                 // round-robin for outside submitters
+    std::atomic<long long> steals;
+    
+    std::mutex idleMutex;
+    std::condition_variable jobAvailable;
+    bool stopping;
+    
+    void workerLoop(int workerIndex);
+    bool findJob(int workerIndex, Job& job);
+    int currentWorkerIndex() const;
+    
+    static void runChunk(void* state, size_t chunk);
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+};
@@ -0,0 +1,72 @@
+#include "TickGovernor.h"
+
+static const double SMOOTHING = 0.1;           // weight of the newest tick in the average
+static const int DEGRADE_AFTER_TICKS = 10;     // consecutive ticks over budget
+static const int RECOVER_AFTER_TICKS = 200;    // consecutive ticks under the recovery threshold
+static const double RECOVERY_FRACTION = 0.5;   // of the budget
+
+TickGovernor::TickGovernor(double budgetMs)
+    : enabled(true), budgetMs(budgetMs), averageMs(0.0), overBudgetTicks(0),
+      underBudgetTicks(0), level(FidelityLevel::FULL), history(HISTORY_SIZE), decisionCount(0) {}
+
+void TickGovernor::setBudget(double milliseconds) {
+    if (milliseconds > 0.0) {
+        budgetMs = milliseconds;
+    }
+}
+
+void TickGovernor::reset() {
+    averageMs = 0.0;
+    overBudgetTicks = 0;
+    underBudgetTicks = 0;
+    level = FidelityLevel::FULL;
+}
+
+bool TickGovernor::recordTick(long long tick, double tickMs, const std::string& slowestPhase,
+                              double slowestPhaseMs) {
+    if (!enabled) return false;
+    
+    averageMs = averageMs == 0.0 ? tickMs : averageMs + SMOOTHING * (tickMs - averageMs);
+    
+    FidelityLevel next = level;
+    if (averageMs > budgetMs) {
+        underBudgetTicks = 0;
+        if (++overBudgetTicks >= DEGRADE_AFTER_TICKS && level != FidelityLevel::COARSE_STEPS) {
+            next = static_cast<FidelityLevel>(static_cast<int>(level) + 1);
+        }
+    } else if (averageMs < budgetMs * RECOVERY_FRACTION) {
+        overBudgetTicks = 0;
+        if (++underBudgetTicks >= RECOVER_AFTER_TICKS && level != FidelityLevel::FULL) {
+            next = static_cast<FidelityLevel>(static_cast<int>(level) - 1);
+        }
+    } else {
+        overBudgetTicks = 0;
+        underBudgetTicks = 0;
+    }
+    
+    if (next == level) return false;
+    
+    GovernorDecision& decision = history[decisionCount % HISTORY_SIZE];
+    decision.tick = tick;
+    decision.from = level;
+    decision.to = next;
+    decision.averageMs = averageMs;
+    decision.slowestPhase = slowestPhase;
+    decision.slowestPhaseMs = slowestPhaseMs;
+    decisionCount++;
+    
+    level = next;
+    overBudgetTicks = 0;
+    underBudgetTicks = 0;
+    return true;
+}
+
+const char* fidelityLevelName(FidelityLevel level) {
+    switch (level) {
+        case FidelityLevel::FULL: return "full fidelity";
+        case FidelityLevel::DEFERRED_WEATHER: return "deferred weather";
+        case FidelityLevel::REDUCED_AI: return "reduced AI rate";
+        case FidelityLevel::COARSE_STEPS: return "coarse substeps";
+        default: return "unknown";
+    }
+}
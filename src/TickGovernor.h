@@ -0,0 +1,59 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Fidelity steps, cheapest sacrifice first
+enum class FidelityLevel {
+    FULL,               // everything every tick
+    DEFERRED_WEATHER,   // weather and wind batched over several ticks
+    REDUCED_AI,         // enemy LOD tiers stretched
+    COARSE_STEPS        // simulation step doubled, half the substeps
+};
+
+struct GovernorDecision {
+    long long tick;
+    FidelityLevel from;
+    FidelityLevel to;
+    double averageMs;           // smoothed tick cost that triggered the change
+    std::string slowestPhase;
+    double slowestPhaseMs;
+};
+
+// Watches real-time tick cost against a budget and steps fidelity down
+// when it overruns, back up once there is headroom again. Hysteresis keeps
+// a single slow tick from flipping the level.
+class TickGovernor {
+public:
+    explicit TickGovernor(double budgetMs = 5.0);
+    
+    void setEnabled(bool value) { enabled = value; }
+    bool isEnabled() const { return enabled; }
+    void setBudget(double milliseconds);
+    double getBudget() const { return budgetMs; }
+    
+    // Feeds one tick's measurements. Returns true when the level changed;
+    // the decision is then available from getLastDecision().
+    bool recordTick(long long tick, double tickMs, const std::string& slowestPhase, double slowestPhaseMs);
+    void reset();
+    
+    FidelityLevel getLevel() const { return level; }
+    double getAverageMs() const { return averageMs; }
+    long long getDecisionCount() const { return decisionCount; }
+    const GovernorDecision& getLastDecision() const { return history[(decisionCount - 1) % HISTORY_SIZE]; }
+    const std::vector<GovernorDecision>& getHistory() const { return history; }   // ring of the latest decisions
+
+private:
+    static const size_t HISTORY_SIZE = 8;
+    
+    bool enabled;
+    double budgetMs;
+    double averageMs;           // exponentially smoothed tick cost
+    int overBudgetTicks;
+    int underBudgetTicks;
+    FidelityLevel level;
+    
+    std::vector<GovernorDecision> history;
+    long long decisionCount;
+};
+
+const char* fidelityLevelName(FidelityLevel level);
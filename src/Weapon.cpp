@@ -1,70 +1,44 @@
 #include "Weapon.h"
+#include "Archetypes.h"
+#include "SimMath.h"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
 
-Weapon::Weapon(const std::string& name, int minDamage, int maxDamage)
-    : name(name), weaponType(WeaponType::MACHINE_GUN), guidanceType(GuidanceType::NONE),
-      minDamage(minDamage), maxDamage(maxDamage), currentAmmo(100), maxAmmo(100),
-      reloadTimeRemaining(0.0), lockedOn(false), lockOnProgress(0.0),
-      rng(std::random_device{}()), dist(minDamage, maxDamage) {
-    
-    // Default specifications
-    specs.range = 2.0;           // 2km default range
-    specs.lockOnTime = 0.0;      // No lock-on time for unguided weapons
-    specs.reloadTime = 3.0;      // 3 seconds reload
-    specs.accuracy = 0.8;        // 80% base accuracy
-    specs.requiresLOS = true;    // Requires line of sight
-    specs.penetration = 20.0;    // Basic penetration
-    specs.blastRadius = 5.0;     // 5m blast radius
-    
-    initializeGuidanceType();
+Weapon::Weapon(WeaponType type)
+    : weaponType(type), currentAmmo(weaponArchetype(type).ammoCapacity),
+      reloadTimeRemaining(0.0), lockedOn(false), lockOnProgress(0.0) {}
+
+const WeaponArchetype& Weapon::archetype() const {
+    return weaponArchetype(weaponType);
 }
 
-Weapon::Weapon(const std::string& name, WeaponType type, int minDamage, int maxDamage, 
-               int ammoCount, const WeaponSpecs& weaponSpecs)
-    : name(name), weaponType(type), minDamage(minDamage), maxDamage(maxDamage),
-      currentAmmo(ammoCount), maxAmmo(ammoCount), reloadTimeRemaining(0.0),
-      specs(weaponSpecs), lockedOn(false), lockOnProgress(0.0),
-      rng(std::random_device{}()), dist(minDamage, maxDamage) {
-    
-    initializeGuidanceType();
+const char* Weapon::getName() const {
+    return archetype().name;
 }
 
-void Weapon::initializeGuidanceType() {
-    switch (weaponType) {
-        case WeaponType::AIR_TO_AIR_MISSILE:
-            guidanceType = GuidanceType::INFRARED;
-            specs.lockOnTime = 3.0;
-            specs.range = 15.0;
-            break;
-        case WeaponType::AIR_TO_GROUND_MISSILE:
-            guidanceType = GuidanceType::LASER;
-            specs.lockOnTime = 2.0;
-            specs.range = 8.0;
-            break;
-        case WeaponType::GUIDED_MISSILE:
-            guidanceType = GuidanceType::RADAR;
-            specs.lockOnTime = 4.0;
-            specs.range = 20.0;
-            break;
-        case WeaponType::MACHINE_GUN:
-        case WeaponType::CANNON:
-        case WeaponType::ROCKET_POD:
-        case WeaponType::UNGUIDED_ROCKET:
-        default:
-            guidanceType = GuidanceType::NONE;
-            specs.lockOnTime = 0.0;
-            break;
-    }
+int Weapon::getDamage(const RandomService& random, const RandomKey& key) const {
+    return random.uniformInt(archetype().minDamage, archetype().maxDamage, key);
 }
 
-std::string Weapon::getName() const {
-    return name;
+GuidanceType Weapon::getGuidanceType() const {
+    return archetype().guidance;
 }
 
-int Weapon::getDamage() const {
-    return dist(rng);
+int Weapon::getMaxAmmo() const {
+    return archetype().ammoCapacity;
+}
+
+double Weapon::getLockOnTime() const {
+    return archetype().specs.lockOnTime;
+}
+
+double Weapon::getRange() const {
+    return archetype().specs.range;
+}
+
+double Weapon::getArmorPenetration() const {
+    return archetype().specs.penetration;
 }
 
 bool Weapon::consumeAmmo() {
@@ -76,13 +50,14 @@ bool Weapon::consumeAmmo() {
 }
 
 void Weapon::reload() {
-    if (currentAmmo < maxAmmo) {
-        reloadTimeRemaining = specs.reloadTime;
-        std::cout << "Reloading " << name << "..." << std::endl;
+    if (currentAmmo < getMaxAmmo()) {
+        reloadTimeRemaining = archetype().specs.reloadTime;
+        std::cout << "Reloading " << getName() << "..." << std::endl;
     }
 }
 
 bool Weapon::canEngageTarget(double distance, bool hasLineOfSight) const {
+    const WeaponSpecs& specs = archetype().specs;
     if (distance > specs.range) return false;
     if (specs.requiresLOS && !hasLineOfSight) return false;
     if (!hasAmmo()) return false;
@@ -93,32 +68,33 @@ bool Weapon::canEngageTarget(double distance, bool hasLineOfSight) const {
 
 double Weapon::calculateHitProbability(double distance, double targetSpeed, double weatherEffect) const {
     // Base accuracy
-    double hitChance = specs.accuracy;
+    const WeaponSpecs& specs = archetype().specs;
+    SimReal hitChance = static_cast<SimReal>(specs.accuracy);
     
     // Distance factor
-    double rangeFactor = 1.0 - (distance / specs.range);
+    SimReal rangeFactor = SimReal(1) - static_cast<SimReal>(distance / specs.range);
     hitChance *= rangeFactor;
     
     // Target speed factor (harder to hit fast targets)
-    double speedFactor = 1.0 / (1.0 + targetSpeed / 100.0);
+    SimReal speedFactor = SimReal(1) / (SimReal(1) + static_cast<SimReal>(targetSpeed) / SimReal(100));
     hitChance *= speedFactor;
     
     // Weather effect
-    hitChance *= weatherEffect;
+    hitChance *= static_cast<SimReal>(weatherEffect);
     
     // Guidance system bonus
-    switch (guidanceType) {
+    switch (getGuidanceType()) {
         case GuidanceType::INFRARED:
-            hitChance *= 1.3;
+            hitChance *= SimReal(1.3);
             break;
         case GuidanceType::RADAR:
-            hitChance *= 1.4;
+            hitChance *= SimReal(1.4);
             break;
         case GuidanceType::LASER:
-            hitChance *= 1.5;
+            hitChance *= SimReal(1.5);
             break;
         case GuidanceType::GPS:
-            hitChance *= 1.2;
+            hitChance *= SimReal(1.2);
             break;
         case GuidanceType::NONE:
         default:
@@ -126,11 +102,11 @@ double Weapon::calculateHitProbability(double distance, double targetSpeed, doub
     }
     
     // Ensure probability stays within bounds
-    return std::max(0.0, std::min(1.0, hitChance));
+    return std::max(SimReal(0), std::min(SimReal(1), hitChance));
 }
 
 bool Weapon::requiresLockOn() const {
-    return specs.lockOnTime > 0.0;
+    return getLockOnTime() > 0.0;
 }
 
 bool Weapon::lockOnTarget(double distance, double targetSpeed, bool hasRadar) {
@@ -139,24 +115,24 @@ bool Weapon::lockOnTarget(double distance, double targetSpeed, bool hasRadar) {
         return true;
     }
     
-    if (distance > specs.range) return false;
+    if (distance > getRange()) return false;
     
     // Some guidance types require radar
-    if ((guidanceType == GuidanceType::RADAR) && !hasRadar) {
+    if ((getGuidanceType() == GuidanceType::RADAR) && !hasRadar) {
         return false;
     }
     
     lockOnProgress = 0.0;
-    std::cout << "Acquiring lock with " << name << "..." << std::endl;
+    std::cout << "Acquiring lock with " << getName() << "..." << std::endl;
     return true;
 }
 
 void Weapon::updateGuidance(double deltaTime) {
     if (requiresLockOn() && !lockedOn) {
         lockOnProgress += deltaTime;
-        if (lockOnProgress >= specs.lockOnTime) {
+        if (lockOnProgress >= getLockOnTime()) {
             lockedOn = true;
-            std::cout << "Target locked! " << name << " ready to fire." << std::endl;
+            std::cout << "Target locked! " << getName() << " ready to fire." << std::endl;
         }
     }
 }
@@ -167,8 +143,8 @@ void Weapon::update(double deltaTime) {
         reloadTimeRemaining -= deltaTime;
         if (reloadTimeRemaining <= 0) {
             reloadTimeRemaining = 0;
-            currentAmmo = maxAmmo;
-            std::cout << name << " reloaded!" << std::endl;
+            currentAmmo = getMaxAmmo();
+            std::cout << getName() << " reloaded!" << std::endl;
         }
     }
     
@@ -180,43 +156,24 @@ double Weapon::calculateDamageAtRange(double distance) const {
     if (distance <= 0) return 1.0;
     
     // Linear damage reduction with range
-    double rangeFactor = 1.0 - (distance / specs.range);
+    double rangeFactor = 1.0 - (distance / getRange());
     rangeFactor = std::max(0.5, rangeFactor); // Minimum 50% damage at max range
     
     return rangeFactor;
 }
 
-bool Weapon::isEffectiveAgainst(const std::string& targetType) const {
-    switch (weaponType) {
-        case WeaponType::AIR_TO_AIR_MISSILE:
-            return (targetType.find("Drone") != std::string::npos || 
-                    targetType.find("Helicopter") != std::string::npos ||
-                    targetType.find("Jet") != std::string::npos);
-        
-        case WeaponType::AIR_TO_GROUND_MISSILE:
-            return (targetType.find("Tank") != std::string::npos ||
-                    targetType.find("SAM") != std::string::npos ||
-                    targetType.find("AAA") != std::string::npos);
-        
-        case WeaponType::MACHINE_GUN:
-        case WeaponType::CANNON:
-            return (targetType.find("Drone") != std::string::npos ||
-                    targetType.find("Light") != std::string::npos);
-        
-        case WeaponType::ROCKET_POD:
-        case WeaponType::UNGUIDED_ROCKET:
-            return true; // Effective against most targets
-        
-        case WeaponType::GUIDED_MISSILE:
-            return true; // Versatile weapon
-        
-        default:
-            return true;
-    }
+bool Weapon::isEffectiveAgainst(EnemyType targetType) const {
+    return (archetype().effectiveTargets & enemyTypeBit(targetType)) != 0;
+}
+
+uint32_t Weapon::getEffectiveTargets() const {
+    return archetype().effectiveTargets;
 }
 
 void Weapon::showWeaponInfo() const {
-    std::cout << "\n=== " << name << " ===" << std::endl;
+    const WeaponArchetype& info = archetype();
+    const WeaponSpecs& specs = info.specs;
+    std::cout << "\n=== " << info.name << " ===" << std::endl;
     std::cout << "Type: ";
     switch (weaponType) {
         case WeaponType::AIR_TO_AIR_MISSILE: std::cout << "Air-to-Air Missile"; break;
@@ -229,15 +186,15 @@ void Weapon::showWeaponInfo() const {
     }
     std::cout << std::endl;
     
-    std::cout << "Damage: " << minDamage << "-" << maxDamage << std::endl;
+    std::cout << "Damage: " << info.minDamage << "-" << info.maxDamage << std::endl;
     std::cout << "Range: " << std::fixed << std::setprecision(1) << specs.range << " km" << std::endl;
     std::cout << "Accuracy: " << std::fixed << std::setprecision(0) << specs.accuracy * 100 << "%" << std::endl;
-    std::cout << "Ammunition: " << currentAmmo << "/" << maxAmmo << std::endl;
+    std::cout << "Ammunition: " << currentAmmo << "/" << info.ammoCapacity << std::endl;
     
     if (requiresLockOn()) {
         std::cout << "Lock-on time: " << std::fixed << std::setprecision(1) << specs.lockOnTime << " seconds" << std::endl;
         std::cout << "Guidance: ";
-        switch (guidanceType) {
+        switch (info.guidance) {
             case GuidanceType::INFRARED: std::cout << "Infrared"; break;
             case GuidanceType::RADAR: std::cout << "Radar"; break;
             case GuidanceType::LASER: std::cout << "Laser"; break;
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
-#include <random>
+#include "RandomService.h"
+#include "Enemy.h"
 
 enum class WeaponType {
     AIR_TO_AIR_MISSILE,
@@ -30,21 +31,23 @@ struct WeaponSpecs {
     double blastRadius;     // meters
 };
 
+struct WeaponArchetype;
+
+// A weapon on the aircraft. Specs come from the WeaponType's archetype;
+// the instance only tracks ammunition, reload and lock-on.
 class Weapon {
 public:
-    Weapon(const std::string& name, int minDamage, int maxDamage);
-    Weapon(const std::string& name, WeaponType type, int minDamage, int maxDamage, 
-           int ammoCount, const WeaponSpecs& specs);
+    explicit Weapon(WeaponType type);
     
     // Basic properties
-    std::string getName() const;
-    int getDamage() const;
+    const char* getName() const;       // archetype name, no copy
+    int getDamage(const RandomService& random, const RandomKey& key) const;
     WeaponType getType() const { return weaponType; }
-    GuidanceType getGuidanceType() const { return guidanceType; }
+    GuidanceType getGuidanceType() const;
     
     // Ammunition management
     int getAmmoCount() const { return currentAmmo; }
-    int getMaxAmmo() const { return maxAmmo; }
+    int getMaxAmmo() const;
     bool hasAmmo() const { return currentAmmo > 0; }
     void reload();
     bool consumeAmmo();
@@ -54,7 +57,8 @@ public:
     double calculateHitProbability(double distance, double targetSpeed, 
                                    double weatherEffect = 1.0) const;
     bool requiresLockOn() const;
-    double getLockOnTime() const { return specs.lockOnTime; }
+    double getLockOnTime() const;
+    double getRange() const;
     bool isReloading() const { return reloadTimeRemaining > 0; }
     
     // Targeting and guidance
@@ -69,34 +73,23 @@ public:
     
     // Effectiveness calculations
     double calculateDamageAtRange(double distance) const;
-    bool isEffectiveAgainst(const std::string& targetType) const;
-    double getArmorPenetration() const { return specs.penetration; }
+    bool isEffectiveAgainst(EnemyType targetType) const;
+    uint32_t getEffectiveTargets() const;   // enemyTypeBit mask, for EnemyFilter::types
+    double getArmorPenetration() const;
 
 private:
     // Core attributes
-    std::string name;
     WeaponType weaponType;
-    GuidanceType guidanceType;
-    int minDamage;
-    int maxDamage;
     
     // Ammunition
     int currentAmmo;
-    int maxAmmo;
     double reloadTimeRemaining;
     
-    // Technical specifications
-    WeaponSpecs specs;
-    
     // Targeting state
     bool lockedOn;
     double lockOnProgress;  // 0.0 to 1.0
     
-    // Random generation
-    mutable std::mt19937 rng;
-    mutable std::uniform_int_distribution<int> dist;
-    
     // Private methods
-    void initializeGuidanceType();
+    const WeaponArchetype& archetype() const;
     double calculateRangeDamageReduction(double distance) const;
 };
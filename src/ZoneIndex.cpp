@@ -0,0 +1,209 @@
+#include "ZoneIndex.h"
+#include <algorithm>
+#include <cmath>
+
+// Deep enough for FANOUT children at every level of any tree we can index
+static const size_t SEARCH_STACK = 256;
+
+ZoneIndex::ZoneIndex(std::pmr::memory_resource* memory)
+    : zones(memory), nodes(memory), current(false), units(nullptr), revision(0), rebuilds(0) {}
+
+void ZoneIndex::clear() {
+    zones.clear();
+    nodes.clear();
+}
+
+void ZoneIndex::add(const Zone& zone) {
+    zones.push_back(zone);
+}
+
+// Sort-tile-recursive order: sort by x, cut into vertical slices of about
+// sqrt(groups) groups each, and sort every slice by y. Consecutive runs of
+// FANOUT items are then compact tiles.
+template <typename T, typename CenterX, typename CenterY>
+static void tileOrder(T* items, size_t count, size_t fanout, CenterX centerX, CenterY centerY) {
+    std::sort(items, items + count, [&](const T& a, const T& b) { return centerX(a) < centerX(b); });
+    size_t groups = (count + fanout - 1) / fanout;
+    size_t slices = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(groups))));
+    size_t sliceSize = ((groups + slices - 1) / slices) * fanout;
+    for (size_t begin = 0; begin < count; begin += sliceSize) {
+        size_t end = std::min(count, begin + sliceSize);
+        std::sort(items + begin, items + end, [&](const T& a, const T& b) { return centerY(a) < centerY(b); });
+    }
+}
+
+void ZoneIndex::build() {
+    nodes.clear();
+    rebuilds++;
+    if (zones.empty()) return;
+
+    // Leaves over tiles of zones
+    tileOrder(zones.data(), zones.size(), FANOUT,
+              [](const Zone& zone) { return zone.x; }, [](const Zone& zone) { return zone.y; });
+    for (size_t first = 0; first < zones.size(); first += FANOUT) {
+        Node leaf;
+        leaf.first = static_cast<uint32_t>(first);
+        leaf.count = static_cast<uint32_t>(std::min<size_t>(FANOUT, zones.size() - first));
+        leaf.leaf = true;
+        leaf.minX = leaf.minY = INFINITY;
+        leaf.maxX = leaf.maxY = -INFINITY;
+        for (size_t i = first; i < first + leaf.count; ++i) {
+            const Zone& zone = zones[i];
+            leaf.minX = std::min(leaf.minX, zone.x - zone.radius);
+            leaf.minY = std::min(leaf.minY, zone.y - zone.radius);
+            leaf.maxX = std::max(leaf.maxX, zone.x + zone.radius);
+            leaf.maxY = std::max(leaf.maxY, zone.y + zone.radius);
+        }
+        nodes.push_back(leaf);
+    }
+
+    // Each level tiles the one below until a single root is left. A level is
+    // reordered before any parent points into it.
+    size_t levelBegin = 0;
+    size_t levelEnd = nodes.size();
+    while (levelEnd - levelBegin > 1) {
+        tileOrder(nodes.data() + levelBegin, levelEnd - levelBegin, FANOUT,
+                  [](const Node& node) { return node.minX + node.maxX; },
+                  [](const Node& node) { return node.minY + node.maxY; });
+        for (size_t first = levelBegin; first < levelEnd; first += FANOUT) {
+            Node parent;
+            parent.first = static_cast<uint32_t>(first);
+            parent.count = static_cast<uint32_t>(std::min<size_t>(FANOUT, levelEnd - first));
+            parent.leaf = false;
+            parent.minX = parent.minY = INFINITY;
+            parent.maxX = parent.maxY = -INFINITY;
+            for (size_t i = first; i < first + parent.count; ++i) {
+                parent.minX = std::min(parent.minX, nodes[i].minX);
+                parent.minY = std::min(parent.minY, nodes[i].minY);
+                parent.maxX = std::max(parent.maxX, nodes[i].maxX);
+                parent.maxY = std::max(parent.maxY, nodes[i].maxY);
+            }
+            nodes.push_back(parent);
+        }
+        levelBegin = levelEnd;
+        levelEnd = nodes.size();
+    }
+}
+
+void ZoneIndex::update(const EnemyStore& store) {
+    if (current && units == &store && revision == store.getRevision()) return;
+    current = true;
+    units = &store;
+    revision = store.getRevision();
+
+    // Capacity only grows, so steady rebuilds do not allocate
+    zones.clear();
+    for (size_t i = 0; i < store.size(); ++i) {
+        const EnemyView unit = store[i];
+        double reach = unit.getCapabilities().engagementRange;
+        if (!unit.isAlive() || reach <= 0.0) continue;
+        zones.push_back(Zone(unit.getPosition().x, unit.getPosition().y, reach, ZONE_ENGAGEMENT, store.getHandle(i)));
+    }
+    build();
+}
+
+template <typename BoxTest, typename ZoneTest, typename Visit>
+void ZoneIndex::search(BoxTest boxTest, ZoneTest zoneTest, unsigned kinds, Visit visit) const {
+    if (nodes.empty()) return;
+    uint32_t stack[SEARCH_STACK];
+    size_t top = 0;
+    stack[top++] = static_cast<uint32_t>(nodes.size() - 1);
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (!boxTest(node)) continue;
+        if (node.leaf) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                if ((zones[i].kind & kinds) && zoneTest(zones[i]) && !visit(static_cast<size_t>(i))) return;
+            }
+        } else {
+            for (uint32_t child = node.first; child < node.first + node.count; ++child) {
+                stack[top++] = child;
+            }
+        }
+    }
+}
+
+// Point tests
+
+static bool boxHolds(double minX, double minY, double maxX, double maxY, double x, double y) {
+    return x >= minX && x <= maxX && y >= minY && y <= maxY;
+}
+
+static bool zoneHolds(const Zone& zone, double x, double y) {
+    double dx = x - zone.x;
+    double dy = y - zone.y;
+    return dx * dx + dy * dy < zone.radius * zone.radius;
+}
+
+bool ZoneIndex::contains(double x, double y, unsigned kinds) const {
+    bool found = false;
+    search([x, y](const Node& node) { return boxHolds(node.minX, node.minY, node.maxX, node.maxY, x, y); },
+           [x, y](const Zone& zone) { return zoneHolds(zone, x, y); }, kinds,
+           [&found](size_t) { found = true; return false; });
+    return found;
+}
+
+void ZoneIndex::queryPoint(double x, double y, unsigned kinds, std::vector<size_t>& matches) const {
+    matches.clear();
+    search([x, y](const Node& node) { return boxHolds(node.minX, node.minY, node.maxX, node.maxY, x, y); },
+           [x, y](const Zone& zone) { return zoneHolds(zone, x, y); }, kinds,
+           [&matches](size_t zone) { matches.push_back(zone); return true; });
+    std::sort(matches.begin(), matches.end());
+}
+
+// Segment tests
+
+struct Segment {
+    double x0, y0, dx, dy;
+};
+
+// Slab test: clip the segment's parameter range against both axes
+static bool segmentHitsBox(const Segment& s, double minX, double minY, double maxX, double maxY) {
+    double enter = 0.0, leave = 1.0;
+    const double origins[2] = { s.x0, s.y0 };
+    const double directions[2] = { s.dx, s.dy };
+    const double lows[2] = { minX, minY };
+    const double highs[2] = { maxX, maxY };
+    for (int axis = 0; axis < 2; ++axis) {
+        if (directions[axis] == 0.0) {
+            if (origins[axis] < lows[axis] || origins[axis] > highs[axis]) return false;
+            continue;
+        }
+        double a = (lows[axis] - origins[axis]) / directions[axis];
+        double b = (highs[axis] - origins[axis]) / directions[axis];
+        enter = std::max(enter, std::min(a, b));
+        leave = std::min(leave, std::max(a, b));
+        if (enter > leave) return false;
+    }
+    return true;
+}
+
+static bool segmentHitsZone(const Segment& s, const Zone& zone) {
+    // Closest point of the segment to the centre
+    double lengthSquared = s.dx * s.dx + s.dy * s.dy;
+    double t = 0.0;
+    if (lengthSquared > 0.0) {
+        t = ((zone.x - s.x0) * s.dx + (zone.y - s.y0) * s.dy) / lengthSquared;
+        t = std::max(0.0, std::min(1.0, t));
+    }
+    return zoneHolds(zone, s.x0 + t * s.dx, s.y0 + t * s.dy);
+}
+
+bool ZoneIndex::crosses(double x0, double y0, double x1, double y1, unsigned kinds) const {
+    Segment s = { x0, y0, x1 - x0, y1 - y0 };
+    bool found = false;
+    search([&s](const Node& node) { return segmentHitsBox(s, node.minX, node.minY, node.maxX, node.maxY); },
+           [&s](const Zone& zone) { return segmentHitsZone(s, zone); }, kinds,
+           [&found](size_t) { found = true; return false; });
+    return found;
+}
+
+void ZoneIndex::querySegment(double x0, double y0, double x1, double y1, unsigned kinds,
+                             std::vector<size_t>& matches) const {
+    matches.clear();
+    Segment s = { x0, y0, x1 - x0, y1 - y0 };
+    search([&s](const Node& node) { return segmentHitsBox(s, node.minX, node.minY, node.maxX, node.maxY); },
+           [&s](const Zone& zone) { return segmentHitsZone(s, zone); }, kinds,
+           [&matches](size_t zone) { matches.push_back(zone); return true; });
+    std::sort(matches.begin(), matches.end());
+}
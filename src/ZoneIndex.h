@@ -0,0 +1,88 @@
+#pragma once
+#include "EnemyStore.h"
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// What a zone is, combined into masks for queries
+enum ZoneKind : unsigned {
+    ZONE_NO_FLY = 1u << 0,
+    ZONE_THREAT = 1u << 1,
+    ZONE_ENGAGEMENT = 1u << 2,      // an enemy unit's weapon reach
+    ZONE_ANY = ZONE_NO_FLY | ZONE_THREAT | ZONE_ENGAGEMENT
+};
+
+// A circle on the map; a point is inside when it is closer to the centre
+// than the radius
+struct Zone {
+    double x, y;                // centre, km
+    double radius;              // km
+    ZoneKind kind;
+    EnemyHandle unit;           // owner of an engagement envelope
+
+    Zone(double x, double y, double radius, ZoneKind kind, EnemyHandle unit = EnemyHandle())
+        : x(x), y(y), radius(radius), kind(kind), unit(unit) {}
+};
+
+// Packed R-tree over circular zones: leaves hold up to FANOUT zones, each
+// node the bounding box of its children, built bottom-up by sort-tile-
+// recursive packing so siblings barely overlap. A point query descends only
+// into boxes holding the point, so it visits O(log n) nodes when zones are
+// spread out; a segment query follows the boxes along the segment. Queries
+// keep their stack on the stack and never allocate.
+//
+// build() sorts the zones into leaf order, and the zone indices queries
+// return refer to that order.
+class ZoneIndex {
+public:
+    explicit ZoneIndex(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    void clear();
+    void add(const Zone& zone);
+    void build();
+
+    // The engagement envelopes of every unit with a weapon still alive,
+    // rebuilt when invalidated or units were added or removed
+    void update(const EnemyStore& units);
+    void invalidate() { current = false; }
+
+    size_t size() const { return zones.size(); }
+    const Zone& operator[](size_t index) const { return zones[index]; }
+
+    // Zones of the given kinds containing (x, y), or crossed anywhere by
+    // the segment from (x0, y0) to (x1, y1); matches in ascending order.
+    // Zones added since the last build() are not seen.
+    bool contains(double x, double y, unsigned kinds = ZONE_ANY) const;
+    void queryPoint(double x, double y, unsigned kinds, std::vector<size_t>& matches) const;
+    bool crosses(double x0, double y0, double x1, double y1, unsigned kinds = ZONE_ANY) const;
+    void querySegment(double x0, double y0, double x1, double y1, unsigned kinds,
+                      std::vector<size_t>& matches) const;
+
+    long long getRebuilds() const { return rebuilds; }
+
+private:
+    static const uint32_t FANOUT = 8;
+
+    struct Node {
+        double minX, minY, maxX, maxY;
+        uint32_t first;                 // first child node, or first zone for a leaf
+        uint32_t count;
+        bool leaf;
+    };
+
+    std::pmr::vector<Zone> zones;
+    std::pmr::vector<Node> nodes;       // one level after another, the root last
+
+    // Engagement envelopes only
+    bool current;
+    const EnemyStore* units;
+    unsigned long long revision;
+
+    long long rebuilds;
+
+    // Depth-first search calling visit(zone index) for zones whose box passes
+    // boxTest and that zoneTest accepts; visit returns false to stop
+    template <typename BoxTest, typename ZoneTest, typename Visit>
+    void search(BoxTest boxTest, ZoneTest zoneTest, unsigned kinds, Visit visit) const;
+};
@@ -1,6 +1,34 @@
 #include "HelicopterCombat.h"
+#include "BatchRunner.h"
+#include "Benchmarks.h"
 
-int main() {
+int main(int argc, char* argv[]) {
+    BatchOptions options;
+    if (!BatchRunner::parseArguments(argc, argv, options)) {
+        return 1;
+    }
+    
+    if (options.scalingUnits > 0) {
+        return runEnemyScalingReport(options.scalingUnits, options.threads, 200);
+    }
+    
+    if (options.layoutUnits > 0) {
+        return runEnemyLayoutReport(options.layoutUnits, 200);
+    }
+    
+    if (options.detectionReport) {
+        return runDetectionReport();
+    }
+    
+    if (options.mathReport) {
+        return runMathKernelReport();
+    }
+    
+    if (options.enabled) {
+        BatchRunner runner(options);
+        return runner.run();
+    }
+    
     HelicopterCombat combat;
     combat.run();
     return 0;